@@ -9,9 +9,27 @@
 #include <thread>
 #include <future>
 #include <queue>
+#include <numeric>
 
 using namespace jluna;
 
+struct BenchmarkPoint
+{
+    Float64 _x = 0;
+    Float64 _y = 0;
+    Int64 _id = 0;
+};
+set_usertype_enabled(BenchmarkPoint);
+
+struct BenchmarkIsbitsPoint
+{
+    Float64 _x = 0;
+    Float64 _y = 0;
+    Int64 _id = 0;
+};
+set_usertype_enabled(BenchmarkIsbitsPoint);
+make_usertype_implicitly_convertible(BenchmarkIsbitsPoint);
+
 int main()
 {
     initialize(1);
@@ -160,6 +178,33 @@ int main()
         f_proxy();
     });
 
+    // jluna::Function
+    auto f_function = jluna::Function<void()>(f_ptr);
+    Benchmark::run("jluna::Function", n_reps, [&](){
+
+        f_function();
+    });
+
+    // typed call, dispatch and boxing vs. compiled specialization
+    Main.safe_eval("g(x::Float64, y::Float64) = x * y + 1");
+    auto* g_ptr = unsafe::get_function(jl_main_module, "g"_sym);
+
+    Benchmark::run_as_base("typed: unsafe::call", n_reps, [&](){
+
+        volatile auto res = jl_unbox_float64(unsafe::call(g_ptr, jl_box_float64(1.5), jl_box_float64(2.5)));
+    });
+
+    Benchmark::run("typed: jluna::safe_call", n_reps, [&](){
+
+        volatile auto res = jl_unbox_float64(jluna::safe_call(g_ptr, jl_box_float64(1.5), jl_box_float64(2.5)));
+    });
+
+    auto g_function = jluna::Function<Float64(Float64, Float64)>(g_ptr);
+    Benchmark::run("typed: jluna::Function (compiled)", n_reps, [&](){
+
+        volatile auto res = g_function(1.5, 2.5);
+    });
+
     //Benchmark::conclude();
     //Benchmark::save();
     //return 0;
@@ -248,6 +293,335 @@ int main()
     //Benchmark::save();
     //return 0;
 
+    // ### BOXING VECTORS ###
+    n_reps = 1000;
+
+    for (size_t size : {16, 1024, 1000000})
+    {
+        auto to_box = std::vector<Float64>();
+        to_box.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+            to_box.push_back(generate_number<Float64>());
+
+        auto* boxed = box<std::vector<Float64>>(to_box);
+        auto boxed_id = unsafe::gc_preserve(boxed);
+
+        // element-wise, jluna behavior prior to bulk copy for isbits types
+        Benchmark::run_as_base("box vector: element-wise (" + std::to_string(size) + ")", n_reps, [&](){
+
+            gc_pause;
+            auto* out = unsafe::new_array((unsafe::Value*) as_julia_type<Float64>::type(), to_box.size());
+            for (size_t i = 0; i < to_box.size(); ++i)
+                jl_arrayset(out, box<Float64>(to_box.at(i)), i);
+
+            volatile auto* res = out;
+            gc_unpause;
+        });
+
+        Benchmark::run("box vector: bulk (" + std::to_string(size) + ")", n_reps, [&](){
+            volatile auto* res = box<std::vector<Float64>>(to_box);
+        });
+
+        // one vector per repetition, each is moved into Julia. Limited to 128 MB in total
+        uint64_t n_move_reps = std::min<uint64_t>(n_reps, (uint64_t(1) << 24) / size);
+        auto to_move = std::vector<std::vector<Float64>>(n_move_reps, to_box);
+        uint64_t move_i = 0;
+
+        Benchmark::run("box vector: move (" + std::to_string(size) + ")", n_move_reps, [&](){
+            volatile auto* res = box<std::vector<Float64>>(std::move(to_move.at(move_i++)));
+        });
+
+        Benchmark::run_as_base("unbox vector: element-wise (" + std::to_string(size) + ")", n_reps, [&](){
+
+            auto* in = (jl_array_t*) boxed;
+            auto out = std::vector<Float64>();
+            out.reserve(in->length);
+
+            for (size_t i = 0; i < in->length; ++i)
+                out.emplace_back(unbox<Float64>(jl_arrayref(in, i)));
+        });
+
+        Benchmark::run("unbox vector: bulk (" + std::to_string(size) + ")", n_reps, [&](){
+            auto out = unbox<std::vector<Float64>>(boxed);
+        });
+
+        unsafe::gc_release(boxed_id);
+    }
+
+    // ### BOXING COMPLEX ###
+    n_reps = 100000;
+
+    {
+        auto to_box = std::complex<double>(generate_number<Float64>(), generate_number<Float64>());
+
+        // via jluna.new_complex, jluna behavior prior to jl_new_bits
+        Benchmark::run_as_base("box complex: new_complex", n_reps, [&](){
+
+            static jl_function_t* complex = unsafe::get_function("jluna"_sym, "new_complex"_sym);
+
+            gc_pause;
+            volatile auto* res = safe_call(complex, box<Float64>(to_box.real()), box<Float64>(to_box.imag()));
+            gc_unpause;
+        });
+
+        Benchmark::run("box complex: direct", n_reps, [&](){
+            volatile auto* res = box<std::complex<double>>(to_box);
+        });
+
+        auto* boxed = box<std::complex<double>>(to_box);
+        auto boxed_id = unsafe::gc_preserve(boxed);
+
+        // via Base.convert, jluna behavior prior to direct read
+        Benchmark::run_as_base("unbox complex: convert", n_reps, [&](){
+
+            gc_pause;
+            auto* res = detail::convert(as_julia_type<std::complex<double>>::type(), boxed);
+            volatile auto out = std::complex<double>(unbox<double>(jl_get_nth_field(res, 0)), unbox<double>(jl_get_nth_field(res, 1)));
+            gc_unpause;
+        });
+
+        Benchmark::run("unbox complex: direct", n_reps, [&](){
+            volatile auto res = unbox<std::complex<double>>(boxed).real();
+        });
+
+        unsafe::gc_release(boxed_id);
+    }
+
+    // ### BOXING USERTYPES ###
+    n_reps = 100000;
+
+    {
+        Usertype<BenchmarkPoint>::add_field("_x", &BenchmarkPoint::_x);
+        Usertype<BenchmarkPoint>::add_field("_y", &BenchmarkPoint::_y);
+        Usertype<BenchmarkPoint>::add_field("_id", &BenchmarkPoint::_id);
+        Usertype<BenchmarkPoint>::implement();
+
+        Usertype<BenchmarkIsbitsPoint>::add_field("_x", &BenchmarkIsbitsPoint::_x);
+        Usertype<BenchmarkIsbitsPoint>::add_field("_y", &BenchmarkIsbitsPoint::_y);
+        Usertype<BenchmarkIsbitsPoint>::add_field("_id", &BenchmarkIsbitsPoint::_id);
+        Usertype<BenchmarkIsbitsPoint>::implement_as_isbits();
+
+        auto point = BenchmarkPoint{generate_number<Float64>(), generate_number<Float64>(), generate_number<Int64>()};
+        auto isbits_point = BenchmarkIsbitsPoint{point._x, point._y, point._id};
+
+        // mutable struct, each field boxed and set separately
+        Benchmark::run_as_base("box usertype: mutable", n_reps, [&](){
+            gc_pause;
+            volatile auto* res = box<BenchmarkPoint>(point);
+            gc_unpause;
+        });
+
+        Benchmark::run("box usertype: isbits", n_reps, [&](){
+            volatile auto* res = box<BenchmarkIsbitsPoint>(isbits_point);
+        });
+
+        auto* boxed = box<BenchmarkPoint>(point);
+        auto boxed_id = unsafe::gc_preserve(boxed);
+
+        Benchmark::run_as_base("unbox usertype: mutable", n_reps, [&](){
+            gc_pause;
+            volatile auto res = unbox<BenchmarkPoint>(boxed)._id;
+            gc_unpause;
+        });
+
+        auto* isbits_boxed = box<BenchmarkIsbitsPoint>(isbits_point);
+        auto isbits_boxed_id = unsafe::gc_preserve(isbits_boxed);
+
+        Benchmark::run("unbox usertype: isbits", n_reps, [&](){
+            volatile auto res = unbox<BenchmarkIsbitsPoint>(isbits_boxed)._id;
+        });
+
+        unsafe::gc_release(boxed_id);
+        unsafe::gc_release(isbits_boxed_id);
+
+        auto vec = std::vector<BenchmarkIsbitsPoint>(1000, isbits_point);
+
+        Benchmark::run("box usertype: vector isbits", n_reps / 100, [&](){
+            volatile auto* res = box<std::vector<BenchmarkIsbitsPoint>>(vec);
+        });
+    }
+
+    // ### BOXING STRINGS ###
+    n_reps = 100000;
+
+    {
+        auto to_box = std::string("GET /index.html");
+
+        // via Array{UInt8}, jluna behavior prior to jl_pchar_to_string
+        Benchmark::run_as_base("box string: via array", n_reps, [&](){
+
+            gc_pause;
+            auto* array = unsafe::new_array_from_data((unsafe::Value*) as_julia_type<char>::type(), to_box.data(), to_box.size());
+            volatile auto* res = jl_array_to_string(array);
+            gc_unpause;
+        });
+
+        Benchmark::run("box string: direct", n_reps, [&](){
+            volatile auto* res = box<std::string>(to_box);
+        });
+
+        Benchmark::run("box string: interned", n_reps, [&](){
+            volatile auto* res = box_interned(to_box);
+        });
+
+        auto* boxed = box<std::string>(to_box);
+        auto boxed_id = unsafe::gc_preserve(boxed);
+
+        Benchmark::run_as_base("unbox string: std::string", n_reps, [&](){
+            volatile auto res = unbox<std::string>(boxed).size();
+        });
+
+        Benchmark::run("unbox string: std::string_view", n_reps, [&](){
+            volatile auto res = unbox<std::string_view>(boxed).size();
+        });
+
+        unsafe::gc_release(boxed_id);
+        clear_interned_strings();
+    }
+
+    // ### BOXING DICTS ###
+    n_reps = 100;
+
+    for (size_t size : {16, 1024, 100000})
+    {
+        auto to_box = std::unordered_map<Int64, Float64>();
+        to_box.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+            to_box.insert({i, generate_number<Float64>()});
+
+        // element-wise, jluna behavior prior to bulk construction
+        Benchmark::run_as_base("box dict: element-wise (" + std::to_string(size) + ")", n_reps, [&](){
+
+            static auto* new_dict = unsafe::get_function("jluna"_sym, "new_dict"_sym);
+            static auto* setindex = unsafe::get_function(jl_base_module, "setindex!"_sym);
+
+            gc_pause;
+            auto* out = unsafe::call(new_dict, as_julia_type<Int64>::type(), as_julia_type<Float64>::type(), box<UInt64>(to_box.size()));
+            for (auto& pair : to_box)
+                safe_call(setindex, out, box<Float64>(pair.second), box<Int64>(pair.first));
+
+            volatile auto* res = out;
+            gc_unpause;
+        });
+
+        Benchmark::run("box dict: bulk (" + std::to_string(size) + ")", n_reps, [&](){
+            volatile auto* res = box<std::unordered_map<Int64, Float64>>(to_box);
+        });
+
+        auto* boxed = box<std::unordered_map<Int64, Float64>>(to_box);
+        auto boxed_id = unsafe::gc_preserve(boxed);
+
+        // element-wise, jluna behavior prior to bulk unboxing
+        Benchmark::run_as_base("unbox dict: element-wise (" + std::to_string(size) + ")", n_reps, [&](){
+
+            static jl_function_t* iterate = jl_get_function(jl_base_module, "iterate");
+
+            gc_pause;
+            auto out = std::unordered_map<Int64, Float64>();
+            auto* it_res = jl_call2(iterate, boxed, jl_box_int64(1));
+            while (it_res != jl_nothing)
+            {
+                out.insert(unbox<std::pair<Int64, Float64>>(jl_get_nth_field(it_res, 0)));
+                it_res = jl_call2(iterate, boxed, jl_get_nth_field(it_res, 1));
+            }
+            gc_unpause;
+        });
+
+        Benchmark::run("unbox dict: bulk (" + std::to_string(size) + ")", n_reps, [&](){
+            auto out = unbox<std::unordered_map<Int64, Float64>>(boxed);
+        });
+
+        unsafe::gc_release(boxed_id);
+    }
+
+    // ### ITERATING ARRAYS ###
+    n_reps = 100;
+
+    {
+        Vector<Float64> array = Main.safe_eval("return rand(Float64, 100_000)");
+        auto as_vector = unbox<std::vector<Float64>>(array);
+
+        Benchmark::run_as_base("accumulate: std::vector", n_reps, [&](){
+            volatile auto res = std::accumulate(as_vector.begin(), as_vector.end(), 0.0);
+        });
+
+        Benchmark::run("accumulate: Array::Iterator", n_reps, [&](){
+            Float64 sum = 0;
+            for (auto it = array.begin(); it != array.end(); ++it)
+                sum += static_cast<Float64>(*it);
+
+            volatile auto res = sum;
+        });
+
+        Benchmark::run("accumulate: Array::raw_begin", n_reps, [&](){
+            volatile auto res = std::accumulate(array.raw_begin(), array.raw_end(), 0.0);
+        });
+
+        const auto& as_const = array;
+        Benchmark::run("at: Array", n_reps, [&](){
+            Float64 sum = 0;
+            for (uint64_t i = 0; i < as_const.get_n_elements(); ++i)
+                sum += as_const.at(i);
+
+            volatile auto res = sum;
+        });
+
+        array.set_metadata_caching_enabled(true);
+        Benchmark::run("at: Array (metadata cached)", n_reps, [&](){
+            Float64 sum = 0;
+            for (uint64_t i = 0; i < as_const.get_n_elements(); ++i)
+                sum += as_const.at(i);
+
+            volatile auto res = sum;
+        });
+    }
+
+    // ### SIMD KERNELS ###
+    n_reps = 1000;
+
+    for (size_t size : {16, 1024, 1000000})
+    {
+        Main.safe_eval("simd_a = rand(Float64, " + std::to_string(size) + "); simd_b = rand(Float64, " + std::to_string(size) + "); simd_c = rand(Float64, " + std::to_string(size) + ")");
+        Vector<Float64> a = Main["simd_a"];
+        Vector<Float64> b = Main["simd_b"];
+        Vector<Float64> c = Main["simd_c"];
+        Vector<Float64> tmp = Main.safe_eval("return simd_tmp = similar(simd_a)");
+
+        Benchmark::run_as_base("add: Julia broadcast (" + std::to_string(size) + ")", n_reps, [&](){
+            Main.safe_eval("simd_a .+= simd_b");
+        });
+
+        Benchmark::run("add: simd::add (" + std::to_string(size) + ")", n_reps, [&](){
+            simd::add(a, b, a);
+        });
+
+        Benchmark::run_as_base("a .* b .+ c .- a: Julia broadcast (" + std::to_string(size) + ")", n_reps, [&](){
+            Main.safe_eval("simd_tmp .= simd_a .* simd_b .+ simd_c .- simd_a");
+        });
+
+        Benchmark::run("a .* b .+ c .- a: simd eager (" + std::to_string(size) + ")", n_reps, [&](){
+            simd::multiply(a, b, tmp);
+            simd::add(tmp, c, tmp);
+            simd::subtract(tmp, a, tmp);
+        });
+
+        Benchmark::run("a .* b .+ c .- a: simd::assign (" + std::to_string(size) + ")", n_reps, [&](){
+            simd::assign(tmp, simd::expr(a) * b + c - a);
+        });
+
+        Benchmark::run_as_base("sum: Julia (" + std::to_string(size) + ")", n_reps, [&](){
+            volatile Float64 res = Main.safe_eval("return sum(simd_a)");
+        });
+
+        Benchmark::run("sum: simd::sum (" + std::to_string(size) + ")", n_reps, [&](){
+            volatile Float64 res = simd::sum(a);
+        });
+    }
+
+    //Benchmark::conclude();
+    //Benchmark::save();
+    //return 0;
+
     // ### JLUNA TASK ###
 
     // setup 1-thread threapool
@@ -311,6 +685,38 @@ int main()
         });
     });
 
+    n_reps = 1000;
+    const size_t n_tasks = 1000;
+
+    // fan-out, one call into Julia per task
+    Benchmark::run_as_base("threading: create & schedule 1000 tasks", n_reps, [&]()
+    {
+        std::vector<Task<void>> tasks;
+        tasks.reserve(n_tasks);
+
+        for (size_t i = 0; i < n_tasks; ++i)
+            tasks.push_back(ThreadPool::create<void()>(task));
+
+        for (auto& t : tasks)
+            t.schedule();
+
+        for (auto& t : tasks)
+            t.join();
+    });
+
+    // fan-out, one call into Julia per batch
+    Benchmark::run("threading: create_batch & schedule_batch 1000 tasks", n_reps, [&]()
+    {
+        auto tasks = ThreadPool::create_batch(n_tasks, [&](uint64_t) {
+            task();
+        });
+
+        ThreadPool::schedule_batch(tasks);
+
+        for (auto& t : tasks)
+            t.join();
+    });
+
     shutdown = true;
     thread.detach();
     queue_cv.notify_all();
@@ -0,0 +1,53 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#include <jluna.hpp>
+#include <.benchmark/benchmark.hpp>
+#include <thread>
+#include <cmath>
+
+using namespace jluna;
+
+// measures scaling of parallel_for / parallel_reduce compared to a single-threaded loop over the raw data
+// usage: jluna_benchmark_parallel_algorithms [n_threads]
+int main(int argc, char** argv)
+{
+    const size_t n_threads = argc > 1 ? std::stoul(argv[1]) : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    initialize(n_threads);
+    Benchmark::initialize();
+
+    const size_t n_reps = 50;
+
+    Vector<Float64> array = Main.safe_eval("return rand(Float64, 10_000_000)");
+    auto* data = reinterpret_cast<Float64*>(array.data());
+    auto n = array.get_n_elements();
+
+    Benchmark::run_as_base("for: single-threaded", n_reps, [&](){
+        for (size_t i = 0; i < n; ++i)
+            data[i] = std::sqrt(data[i] * data[i] + 1);
+    });
+
+    Benchmark::run("for: parallel_for (" + std::to_string(ThreadPool::n_threads()) + " threads)", n_reps, [&](){
+        parallel_for(array, [](Float64& x){
+            x = std::sqrt(x * x + 1);
+        });
+    });
+
+    Benchmark::run_as_base("reduce: single-threaded", n_reps, [&](){
+        volatile Float64 sum = 0;
+        Float64 local = 0;
+        for (size_t i = 0; i < n; ++i)
+            local += data[i];
+        sum = local;
+    });
+
+    Benchmark::run("reduce: parallel_reduce (" + std::to_string(ThreadPool::n_threads()) + " threads)", n_reps, [&](){
+        volatile Float64 sum = parallel_reduce(array, 0.0, [](Float64 a, Float64 b) {
+            return a + b;
+        });
+    });
+
+    Benchmark::conclude();
+    return 0;
+}
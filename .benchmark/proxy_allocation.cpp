@@ -0,0 +1,70 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#include <jluna.hpp>
+#include <.benchmark/benchmark.hpp>
+#include <thread>
+
+using namespace jluna;
+
+// measures proxy allocation throughput when 1 to N Julia threads create proxies concurrently
+// usage: jluna_benchmark_proxy_allocation [max_n_threads]
+int main(int argc, char** argv)
+{
+    const size_t max_n_threads = argc > 1 ? std::stoul(argv[1]) : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    initialize(max_n_threads);
+    Benchmark::initialize();
+
+    // total number of proxies allocated per run, split evenly across all tasks
+    const size_t n_proxies = 100000;
+    const size_t n_reps = 50;
+
+    auto* value = jl_eval_string("return [1, 2, 3, 4]");
+    auto value_id = unsafe::gc_preserve(value);
+
+    std::vector<Benchmark::Result> results;
+
+    for (size_t n_threads = 1; n_threads <= ThreadPool::n_threads(); ++n_threads)
+    {
+        const size_t n_per_task = n_proxies / n_threads;
+
+        auto task = [value, n_per_task]() {
+            for (size_t i = 0; i < n_per_task; ++i)
+                auto proxy = Proxy(value, nullptr);
+        };
+
+        auto run = [&]() {
+
+            std::vector<Task<void>> tasks;
+            tasks.reserve(n_threads);
+
+            for (size_t i = 0; i < n_threads; ++i)
+                tasks.push_back(ThreadPool::create<void()>(task));
+
+            for (auto& t : tasks)
+                t.schedule();
+
+            for (auto& t : tasks)
+                t.join();
+        };
+
+        auto name = "proxy allocation: " + std::to_string(n_threads) + " thread(s)";
+        if (n_threads == 1)
+            results.push_back(Benchmark::run_as_base(name, n_reps, run));
+        else
+            results.push_back(Benchmark::run(name, n_reps, run));
+    }
+
+    unsafe::gc_release(value_id);
+
+    Benchmark::conclude();
+
+    for (auto& result : results)
+    {
+        auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(result._median).count();
+        std::cout << result._name << ": " << size_t(n_proxies / seconds) << " proxies/s" << std::endl;
+    }
+
+    return 0;
+}
@@ -54,6 +54,21 @@ namespace jluna
         {
             static inline const std::string type_name = "Array{" + as_julia_type_aux<Value_t>::type_name + ", " + std::to_string(N) + "}";
         };
+
+        // access raw data of an array whose value type has the same memory layout as the Julia-side element type
+        template<typename Value_t, uint64_t Rank>
+        Value_t* checked_array_data(const Array<Value_t, Rank>& array, const char* function_name)
+        {
+            auto* raw = static_cast<unsafe::Array*>(array);
+            if (jl_array_eltype((unsafe::Value*) raw) != (void*) as_julia_type<Value_t>::type())
+            {
+                std::stringstream str;
+                str << "In jluna::" << function_name << ": value type of array does not match C++-side type " << as_julia_type<Value_t>::type_name;
+                throw std::invalid_argument(str.str());
+            }
+
+            return reinterpret_cast<Value_t*>(raw->data);
+        }
     }
 
     template<is_boxable V, uint64_t R>
@@ -82,15 +97,61 @@ namespace jluna
     template<is_boxable T, uint64_t Rank>
     uint64_t Array<T, Rank>::get_dimension(uint64_t index) const
     {
+        if (_metadata.is_enabled and index < Rank)
+            return get_metadata().size[index];
+
         return jl_array_dim(this->operator unsafe::Array*(), index);
     }
 
     template<is_boxable T, uint64_t Rank>
     Array<T, Rank>::operator unsafe::Array*() const
     {
+        if (_metadata.is_enabled)
+            return get_metadata().array;
+
         return (unsafe::Array*) _content->value();
     }
 
+    template<is_boxable T, uint64_t Rank>
+    const typename Array<T, Rank>::Metadata& Array<T, Rank>::get_metadata() const
+    {
+        if (_metadata.is_valid and _metadata.generation == _content->generation())
+            return _metadata;
+
+        auto* array = (unsafe::Array*) _content->value();
+        const uint64_t n_dims = jl_array_ndims(array);
+
+        _metadata.array = array;
+        _metadata.data = array->data;
+        _metadata.length = array->length;
+
+        for (uint64_t i = 0; i < Rank; ++i)
+            _metadata.size[i] = i < n_dims ? jl_array_dim(array, i) : 1;
+
+        _metadata.generation = _content->generation();
+        _metadata.is_valid = true;
+        return _metadata;
+    }
+
+    template<is_boxable T, uint64_t Rank>
+    void Array<T, Rank>::set_metadata_caching_enabled(bool enabled)
+    {
+        _metadata.is_enabled = enabled;
+        _metadata.is_valid = false;
+    }
+
+    template<is_boxable T, uint64_t Rank>
+    bool Array<T, Rank>::get_metadata_caching_enabled() const
+    {
+        return _metadata.is_enabled;
+    }
+
+    template<is_boxable T, uint64_t Rank>
+    void Array<T, Rank>::update_metadata()
+    {
+        _metadata.is_valid = false;
+    }
+
     template<is_boxable T, uint64_t Rank>
     void Array<T, Rank>::throw_if_index_out_of_range(int index, uint64_t dimension) const
     {
@@ -214,7 +275,13 @@ namespace jluna
             throw std::out_of_range(str.str().c_str());
         }
 
-        return unbox<T>(jl_arrayref((jl_array_t*) _content->value(), i));
+        if constexpr (is_isbits_compatible<V> and std::is_same_v<T, V>)
+        {
+            if (_metadata.is_enabled)
+                return reinterpret_cast<const V*>(get_metadata().data)[i];
+        }
+
+        return unbox<T>(jl_arrayref(this->operator unsafe::Array*(), i));
     }
 
     template<is_boxable V, uint64_t R>
@@ -336,6 +403,50 @@ namespace jluna
         return ConstIterator(get_n_elements(), const_cast<Array<V, R>*>(this));
     }
 
+    template<is_boxable V, uint64_t R>
+    template<typename T, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, V>, bool>>
+    T* Array<V, R>::raw_begin()
+    {
+        return reinterpret_cast<T*>(static_cast<unsafe::Array*>(*this)->data);
+    }
+
+    template<is_boxable V, uint64_t R>
+    template<typename T, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, V>, bool>>
+    const T* Array<V, R>::raw_begin() const
+    {
+        return reinterpret_cast<const T*>(static_cast<unsafe::Array*>(*this)->data);
+    }
+
+    template<is_boxable V, uint64_t R>
+    template<typename T, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, V>, bool>>
+    T* Array<V, R>::raw_end()
+    {
+        auto* array = static_cast<unsafe::Array*>(*this);
+        return reinterpret_cast<T*>(array->data) + array->length;
+    }
+
+    template<is_boxable V, uint64_t R>
+    template<typename T, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, V>, bool>>
+    const T* Array<V, R>::raw_end() const
+    {
+        auto* array = static_cast<unsafe::Array*>(*this);
+        return reinterpret_cast<const T*>(array->data) + array->length;
+    }
+
+    template<is_boxable V, uint64_t R>
+    template<typename T, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, V>, bool>>
+    std::span<T> Array<V, R>::as_span()
+    {
+        return std::span<T>(raw_begin(), raw_end());
+    }
+
+    template<is_boxable V, uint64_t R>
+    template<typename T, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, V>, bool>>
+    std::span<const T> Array<V, R>::as_span() const
+    {
+        return std::span<const T>(raw_begin(), raw_end());
+    }
+
     template<is_boxable V, uint64_t R>
     template<is_unboxable T>
     T Array<V, R>::front() const
@@ -359,12 +470,18 @@ namespace jluna
     template<is_boxable V, uint64_t R>
     uint64_t Array<V, R>::get_n_elements() const
     {
+        if (_metadata.is_enabled)
+            return get_metadata().length;
+
         return reinterpret_cast<const jl_array_t*>(this->operator const unsafe::Value*())->length;
     }
 
     template<is_boxable V, uint64_t R>
     uint64_t Array<V, R>::size(uint64_t dimension_index) const
     {
+        if (_metadata.is_enabled and dimension_index < R)
+            return get_metadata().size[dimension_index];
+
         auto* as = reinterpret_cast<const jl_array_t*>(this->operator const unsafe::Value*());
         return jl_array_dim(as, dimension_index);
     }
@@ -372,18 +489,22 @@ namespace jluna
     template<is_boxable V, uint64_t R>
     bool Array<V, R>::empty() const
     {
-        return reinterpret_cast<const jl_array_t*>(this->operator const unsafe::Value*())->length == 0;
+        return get_n_elements() == 0;
     }
 
     template<is_boxable V, uint64_t R>
     void Array<V, R>::reserve(uint64_t n)
     {
         jl_array_sizehint(reinterpret_cast<jl_array_t*>(this->operator unsafe::Value*()), n);
+        _content->increment_generation();
     }
 
     template<is_boxable V, uint64_t R>
     void* Array<V, R>::data()
     {
+        if (_metadata.is_enabled)
+            return get_metadata().data;
+
         return (operator unsafe::Array*())->data;
     }
 
@@ -432,6 +553,7 @@ namespace jluna
 
         gc_pause;
         jl_call3(insert, _content->value(), jl_box_uint64(pos + 1), box(value));
+        _content->increment_generation();
         forward_last_exception();
         gc_unpause;
     }
@@ -443,6 +565,7 @@ namespace jluna
 
         gc_pause;
         jl_call2(deleteat, _content->value(), jl_box_uint64(pos + 1));
+        _content->increment_generation();
         forward_last_exception();
         gc_unpause;
     }
@@ -455,6 +578,7 @@ namespace jluna
         auto* array = (jl_array_t*) _content->value();
         jl_array_grow_beg(array, 1);
         jl_arrayset((unsafe::Array*) _content->value(), box<V>(value), 0);
+        _content->increment_generation();
         gc_unpause;
     }
 
@@ -466,6 +590,7 @@ namespace jluna
         auto* array = (jl_array_t*) _content->value();
         jl_array_grow_end(array, 1);
         jl_arrayset((unsafe::Array*) _content->value(), box<V>(value), jl_array_len(array)-1);
+        _content->increment_generation();
         gc_unpause;
     }
 }
\ No newline at end of file
@@ -0,0 +1,341 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#include <sstream>
+#include <stdexcept>
+
+namespace jluna
+{
+    template<is_isbits_compatible V, uint64_t R>
+    ArrayView<V, R>::ArrayView(const Array<V, R>& array)
+    {
+        auto* raw = static_cast<unsafe::Array*>(array);
+        detail::assert_type((unsafe::DataType*) jl_array_eltype((unsafe::Value*) raw), (unsafe::DataType*) as_julia_type<V>::type());
+
+        _data = reinterpret_cast<V*>(jl_array_data(raw));
+
+        int64_t stride = 1;
+        for (uint64_t i = 0; i < R; ++i)
+        {
+            _size.at(i) = jl_array_dim(raw, i);
+            _strides.at(i) = stride;
+            stride *= _size.at(i);
+        }
+
+        _owner = make_owner((unsafe::Value*) raw);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    ArrayView<V, R>::ArrayView(unsafe::Value* array)
+    {
+        static auto* get_strided_layout = unsafe::get_function("jluna"_sym, "get_strided_layout"_sym);
+
+        // [pointer, size..., strides...]
+        auto layout = unbox<std::vector<int64_t>>(jluna::safe_call(
+            get_strided_layout,
+            array,
+            (unsafe::Value*) as_julia_type<V>::type(),
+            jl_box_int64(R)
+        ));
+
+        _data = reinterpret_cast<V*>(static_cast<uint64_t>(layout.at(0)));
+        for (uint64_t i = 0; i < R; ++i)
+        {
+            _size.at(i) = layout.at(1 + i);
+            _strides.at(i) = layout.at(1 + R + i);
+        }
+
+        // SubArrays and ReshapedArrays reference their parent, so rooting the view object itself also roots the memory
+        _owner = make_owner(array);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    ArrayView<V, R>::ArrayView(Proxy proxy)
+        : ArrayView(static_cast<unsafe::Value*>(proxy))
+    {}
+
+    template<is_isbits_compatible V, uint64_t R>
+    ArrayView<V, R>::ArrayView(V* data, std::array<uint64_t, R> size, std::array<int64_t, R> strides, unsafe::Value* owner)
+        : ArrayView(make_owner(owner), data, size, strides)
+    {}
+
+    template<is_isbits_compatible V, uint64_t R>
+    ArrayView<V, R>::ArrayView(Owner owner, V* data, std::array<uint64_t, R> size, std::array<int64_t, R> strides)
+        : _data(data), _size(size), _strides(strides), _owner(std::move(owner))
+    {}
+
+    template<is_isbits_compatible V, uint64_t R>
+    typename ArrayView<V, R>::Owner ArrayView<V, R>::make_owner(unsafe::Value* owner)
+    {
+        if (owner == nullptr)
+            return nullptr;
+
+        return Owner(new uint64_t(unsafe::gc_preserve(owner)), [](const uint64_t* id) {
+            unsafe::gc_release(*id);
+            delete id;
+        });
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    void ArrayView<V, R>::throw_if_dimension_out_of_range(uint64_t dimension) const
+    {
+        if (dimension >= R)
+        {
+            std::stringstream str;
+            str << "In jluna::ArrayView: dimension " << dimension << " out of range for view of rank " << R;
+            throw std::out_of_range(str.str());
+        }
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    void ArrayView<V, R>::throw_if_index_out_of_range(uint64_t index, uint64_t dimension) const
+    {
+        if (index >= _size.at(dimension))
+        {
+            std::stringstream str;
+            str << "In jluna::ArrayView: 0-based index " << index << " out of range for view of size " << _size.at(dimension) << " along dimension " << dimension;
+            throw std::out_of_range(str.str());
+        }
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    template<typename... Index_t, std::enable_if_t<sizeof...(Index_t) == R and (std::is_integral_v<Index_t> and ...), bool>>
+    V& ArrayView<V, R>::at(Index_t... index) const
+    {
+        std::array<int64_t, R> indices = {static_cast<int64_t>(index)...};
+
+        int64_t offset = 0;
+        for (uint64_t i = 0; i < R; ++i)
+        {
+            if (indices.at(i) < 0)
+            {
+                std::stringstream str;
+                str << "In jluna::ArrayView: negative index " << indices.at(i) << ", only indices >= 0 are permitted";
+                throw std::out_of_range(str.str());
+            }
+
+            throw_if_index_out_of_range(indices.at(i), i);
+            offset += indices.at(i) * _strides.at(i);
+        }
+
+        return _data[offset];
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    uint64_t ArrayView<V, R>::size(uint64_t dimension) const
+    {
+        throw_if_dimension_out_of_range(dimension);
+        return _size.at(dimension);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    int64_t ArrayView<V, R>::stride(uint64_t dimension) const
+    {
+        throw_if_dimension_out_of_range(dimension);
+        return _strides.at(dimension);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    uint64_t ArrayView<V, R>::get_n_elements() const
+    {
+        uint64_t out = 1;
+        for (auto size : _size)
+            out *= size;
+
+        return out;
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    bool ArrayView<V, R>::empty() const
+    {
+        return get_n_elements() == 0;
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    bool ArrayView<V, R>::is_contiguous() const
+    {
+        int64_t expected = 1;
+        for (uint64_t i = 0; i < R; ++i)
+        {
+            // stride of a dimension of size 1 is irrelevant
+            if (_size.at(i) != 1 and _strides.at(i) != expected)
+                return false;
+
+            expected *= _size.at(i);
+        }
+
+        return true;
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    V* ArrayView<V, R>::data() const
+    {
+        return _data;
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    ArrayView<V, R> ArrayView<V, R>::range(uint64_t dimension, uint64_t first, uint64_t last) const
+    {
+        throw_if_dimension_out_of_range(dimension);
+
+        if (first > last or last > _size.at(dimension))
+        {
+            std::stringstream str;
+            str << "In jluna::ArrayView::range: range [" << first << ", " << last << ") out of range for view of size " << _size.at(dimension) << " along dimension " << dimension;
+            throw std::out_of_range(str.str());
+        }
+
+        auto size = _size;
+        size.at(dimension) = last - first;
+        return ArrayView<V, R>(_owner, _data + static_cast<int64_t>(first) * _strides.at(dimension), size, _strides);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    template<uint64_t Rank, std::enable_if_t<(Rank >= 2), bool>>
+    ArrayView<V, Rank - 1> ArrayView<V, R>::slice(uint64_t dimension, uint64_t index) const
+    {
+        throw_if_dimension_out_of_range(dimension);
+        throw_if_index_out_of_range(index, dimension);
+
+        std::array<uint64_t, R - 1> size;
+        std::array<int64_t, R - 1> strides;
+
+        for (uint64_t i = 0, j = 0; i < R; ++i)
+        {
+            if (i == dimension)
+                continue;
+
+            size.at(j) = _size.at(i);
+            strides.at(j) = _strides.at(i);
+            ++j;
+        }
+
+        return ArrayView<V, R - 1>(_owner, _data + static_cast<int64_t>(index) * _strides.at(dimension), size, strides);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    template<uint64_t Rank, std::enable_if_t<Rank == 2, bool>>
+    ArrayView<V, 1> ArrayView<V, R>::column(uint64_t index) const
+    {
+        return slice(1, index);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    template<uint64_t Rank, std::enable_if_t<Rank == 2, bool>>
+    ArrayView<V, 1> ArrayView<V, R>::row(uint64_t index) const
+    {
+        return slice(0, index);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    template<typename... Dims, std::enable_if_t<(sizeof...(Dims) >= 1) and (std::is_integral_v<Dims> and ...), bool>>
+    ArrayView<V, sizeof...(Dims)> ArrayView<V, R>::reshape(Dims... size_per_dimension) const
+    {
+        constexpr uint64_t N = sizeof...(Dims);
+
+        if (not is_contiguous())
+            throw std::invalid_argument("In jluna::ArrayView::reshape: only contiguous views can be reshaped");
+
+        std::array<uint64_t, N> size = {static_cast<uint64_t>(size_per_dimension)...};
+        std::array<int64_t, N> strides;
+
+        uint64_t n = 1;
+        for (uint64_t i = 0; i < N; ++i)
+        {
+            strides.at(i) = n;
+            n *= size.at(i);
+        }
+
+        if (n != get_n_elements())
+        {
+            std::stringstream str;
+            str << "In jluna::ArrayView::reshape: view has " << get_n_elements() << " elements, but new dimensions would require " << n;
+            throw std::invalid_argument(str.str());
+        }
+
+        return ArrayView<V, N>(_owner, _data, size, strides);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    typename ArrayView<V, R>::Iterator ArrayView<V, R>::begin() const
+    {
+        return Iterator(this, empty());
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    typename ArrayView<V, R>::Iterator ArrayView<V, R>::end() const
+    {
+        return Iterator(this, true);
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    std::span<V> ArrayView<V, R>::as_span() const
+    {
+        if (not is_contiguous())
+            throw std::invalid_argument("In jluna::ArrayView::as_span: only contiguous views can be exposed as a span");
+
+        return std::span<V>(_data, get_n_elements());
+    }
+
+    template<is_boxable V, uint64_t R>
+    template<typename T, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, V>, bool>>
+    ArrayView<T, R> Array<V, R>::as_mdspan() const
+    {
+        return ArrayView<T, R>(*this);
+    }
+
+    // ###
+
+    template<is_isbits_compatible V, uint64_t R>
+    ArrayView<V, R>::Iterator::Iterator(const ArrayView* view, bool at_end)
+        : _view(view), _ptr(at_end ? nullptr : view->_data)
+    {}
+
+    template<is_isbits_compatible V, uint64_t R>
+    V& ArrayView<V, R>::Iterator::operator*() const
+    {
+        return *_ptr;
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    typename ArrayView<V, R>::Iterator& ArrayView<V, R>::Iterator::operator++()
+    {
+        // advance like an odometer, first dimension fastest
+        for (uint64_t i = 0; i < R; ++i)
+        {
+            _index[i] += 1;
+            _ptr += _view->_strides[i];
+
+            if (_index[i] < _view->_size[i])
+                return *this;
+
+            _ptr -= _view->_strides[i] * static_cast<int64_t>(_view->_size[i]);
+            _index[i] = 0;
+        }
+
+        // wrapped around in all dimensions
+        _ptr = nullptr;
+        return *this;
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    typename ArrayView<V, R>::Iterator ArrayView<V, R>::Iterator::operator++(int)
+    {
+        auto out = *this;
+        ++(*this);
+        return out;
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    bool ArrayView<V, R>::Iterator::operator==(const Iterator& other) const
+    {
+        return _ptr == other._ptr and _index == other._index;
+    }
+
+    template<is_isbits_compatible V, uint64_t R>
+    bool ArrayView<V, R>::Iterator::operator!=(const Iterator& other) const
+    {
+        return not (*this == other);
+    }
+}
@@ -0,0 +1,129 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#include <include/box.hpp>
+#include <include/unsafe_utilities.hpp>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace jluna
+{
+    namespace detail
+    {
+        constexpr uint64_t interned_string_max_length = 64;
+        constexpr uint64_t interned_string_max_count = 65536;
+
+        // allows lookup by std::string_view without constructing a std::string
+        struct InternedStringHash
+        {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view str) const
+            {
+                return std::hash<std::string_view>()(str);
+            }
+        };
+
+        struct InternedString
+        {
+            unsafe::Value* value;
+            uint64_t id;
+        };
+
+        // C++-side owners of memory used by Julia-side arrays, keyed by array
+        struct BufferOwner
+        {
+            void* owner;
+            void(*deleter)(void*);
+        };
+
+        static std::mutex _buffer_owners_lock;
+        static std::unordered_map<unsafe::Value*, BufferOwner> _buffer_owners;
+
+        // registered through jl_gc_add_ptr_finalizer, runs after the array was collected and may not call into Julia
+        static void finalize_buffer_owner(void* array)
+        {
+            BufferOwner owner;
+            {
+                std::lock_guard<std::mutex> guard(_buffer_owners_lock);
+                auto it = _buffer_owners.find((unsafe::Value*) array);
+                if (it == _buffer_owners.end())
+                    return;
+
+                owner = it->second;
+                _buffer_owners.erase(it);
+            }
+
+            owner.deleter(owner.owner);
+        }
+
+        void attach_buffer_owner(unsafe::Value* array, void* owner, void(*deleter)(void*))
+        {
+            {
+                std::lock_guard<std::mutex> guard(_buffer_owners_lock);
+                _buffer_owners.insert({array, BufferOwner{owner, deleter}});
+            }
+
+            jl_gc_add_ptr_finalizer(jl_current_task->ptls, array, (void*) &finalize_buffer_owner);
+        }
+
+        static std::mutex _interned_strings_lock;
+        static std::unordered_map<std::string, InternedString, InternedStringHash, std::equal_to<>> _interned_strings;
+    }
+
+    unsafe::Value* box_interned(std::string_view value)
+    {
+        if (value.size() > detail::interned_string_max_length)
+            return box<std::string_view>(value);
+
+        {
+            std::lock_guard<std::mutex> guard(detail::_interned_strings_lock);
+
+            auto it = detail::_interned_strings.find(value);
+            if (it != detail::_interned_strings.end())
+                return it->second.value;
+
+            if (detail::_interned_strings.size() >= detail::interned_string_max_count)
+                return box<std::string_view>(value);
+        }
+
+        // allocating and preserving call into Julia, which may trigger a collection. The lock is not held at that point,
+        // otherwise a thread waiting on it could never reach a safepoint
+        auto* out = box<std::string_view>(value);
+        auto id = unsafe::gc_preserve(out);
+
+        bool inserted = false;
+        unsafe::Value* winner = out;
+        {
+            std::lock_guard<std::mutex> guard(detail::_interned_strings_lock);
+
+            if (detail::_interned_strings.size() < detail::interned_string_max_count)
+            {
+                auto pair = detail::_interned_strings.emplace(std::string(value), detail::InternedString{out, id});
+                inserted = pair.second;
+                winner = pair.first->second.value;
+            }
+        }
+
+        // another thread interned the same string in the meantime, or the table filled up
+        if (not inserted)
+            unsafe::gc_release(id);
+
+        return winner;
+    }
+
+    void clear_interned_strings()
+    {
+        decltype(detail::_interned_strings) to_release;
+        {
+            std::lock_guard<std::mutex> guard(detail::_interned_strings_lock);
+            to_release.swap(detail::_interned_strings);
+        }
+
+        for (auto& pair : to_release)
+            unsafe::gc_release(pair.second.id);
+    }
+}
@@ -6,6 +6,7 @@
 #include <.src/common.hpp>
 
 #include <iostream>
+#include <cstring>
 
 namespace jluna
 {
@@ -131,48 +132,123 @@ namespace jluna
     }
 
     template<is<std::string> T>
+    unsafe::Value* box(const T& value)
+    {
+        return jl_pchar_to_string(value.data(), value.size());
+    }
+
+    template<is<std::string_view> T>
     unsafe::Value* box(T value)
     {
-        gc_pause;
-        auto* array = unsafe::new_array_from_data((unsafe::Value*) as_julia_type<char>::type(), value.data(), value.size());
-        auto* out = jl_array_to_string(array);
-        gc_unpause;
-        return out;
+        return jl_pchar_to_string(value.data(), value.size());
     }
 
     template<is<const char*> T>
     unsafe::Value* box(T value)
     {
-        gc_pause;
-        std::string as_string = value;
-        auto* array = unsafe::new_array_from_data((unsafe::Value*) as_julia_type<char>::type(), as_string.data(), as_string.size());
-        auto* out = jl_array_to_string(array);
-        gc_unpause;
-        return out;
+        return jl_cstr_to_string(value);
     }
 
     template<typename T, typename Value_t, std::enable_if_t<std::is_same_v<T, std::complex<Value_t>>, bool>>
     unsafe::Value* box(T value)
     {
+        if constexpr (is_complex_layout_compatible<Value_t>)
+        {
+            // Complex{Value_t} is isbits and laid out as two consecutive Value_t, just like std::complex
+            static_assert(sizeof(T) == 2 * sizeof(Value_t));
+            return jl_new_bits((unsafe::Value*) as_julia_type<T>::type(), &value);
+        }
+
         static jl_function_t* complex = unsafe::get_function("jluna"_sym, "new_complex"_sym);
-        return safe_call(complex, box<Value_t>(value.real()), box<Value_t>(value.imag()));
+        auto scope = detail::GCRootScope();
+        auto* real = detail::gc_save(box<Value_t>(value.real()));
+        auto* imag = box<Value_t>(value.imag());
+        return safe_call(complex, real, imag);
     }
 
     template<typename T, typename Value_t, std::enable_if_t<std::is_same_v<T, std::vector<Value_t>>, bool>>
     unsafe::Value* box(const T& value)
     {
-        gc_pause;
+        if constexpr (is_isbits_compatible<Value_t> and not std::is_same_v<Value_t, bool>)
+        {
+            // layout is identical julia-side, copy in bulk instead of boxing each element
+            auto* out = unsafe::new_array((unsafe::Value*) as_julia_type<Value_t>::type(), value.size());
+            std::memcpy(out->data, value.data(), value.size() * sizeof(Value_t));
+            return (unsafe::Value*) out;
+        }
+        else if constexpr (is_usertype<Value_t> and std::is_trivially_copyable_v<Value_t>)
+        {
+            // usertypes implemented as isbits are stored inline, c.f. Usertype<T>::implement_as_isbits
+            if (Usertype<Value_t>::is_isbits())
+            {
+                auto* out = unsafe::new_array((unsafe::Value*) as_julia_type<Value_t>::type(), value.size());
+                std::memcpy(out->data, value.data(), value.size() * sizeof(Value_t));
+                return (unsafe::Value*) out;
+            }
+        }
+
+        auto scope = detail::GCRootScope();
         auto* out = unsafe::new_array((unsafe::Value*) as_julia_type<Value_t>::type(), value.size());
+        detail::gc_push(out);
+
         for (uint64_t i = 0; i < value.size(); ++i)
         {
             auto* topush = box<Value_t>(value.at(i));
             jl_arrayset(out, topush, i);
         }
 
-        gc_unpause;
         return (unsafe::Value*) out;
     }
 
+    template<typename T, typename Value_t, std::enable_if_t<std::is_same_v<T, std::vector<Value_t>>, bool>>
+    unsafe::Value* box(T&& value)
+    {
+        if constexpr (is_isbits_compatible<Value_t> and not std::is_same_v<Value_t, bool>)
+        {
+            if (not value.empty())
+            {
+                // array uses the vectors memory, the vector itself is moved to the heap and deleted once the array is collected
+                auto* owner = new std::vector<Value_t>(std::move(value));
+                auto* out = (unsafe::Value*) unsafe::new_array_from_data((unsafe::Value*) as_julia_type<Value_t>::type(), owner->data(), owner->size());
+                detail::attach_buffer_owner(out, owner, [](void* owner) {
+                    delete static_cast<std::vector<Value_t>*>(owner);
+                });
+                return out;
+            }
+        }
+
+        return box<T>(static_cast<const T&>(value));
+    }
+
+    namespace detail
+    {
+        // allocate Vector{Value_t} holding projection(e) for every element e of a container
+        template<typename Value_t, typename Container_t, typename Projection_t>
+        unsafe::Value* box_as_array(const Container_t& container, Projection_t projection)
+        {
+            auto* out = unsafe::new_array((unsafe::Value*) as_julia_type<Value_t>::type(), container.size());
+
+            if constexpr (is_isbits_compatible<Value_t>)
+            {
+                // layout is identical julia-side, write into the array data instead of boxing each element
+                auto* data = reinterpret_cast<Value_t*>(out->data);
+                for (auto& e : container)
+                    *(data++) = projection(e);
+            }
+            else
+            {
+                auto scope = GCRootScope();
+                gc_push(out);
+
+                uint64_t i = 0;
+                for (auto& e : container)
+                    jl_arrayset(out, box<Value_t>(projection(e)), i++);
+            }
+
+            return (unsafe::Value*) out;
+        }
+    }
+
     template<typename T, typename Key_t, typename Value_t, std::enable_if_t<
             std::is_same_v<T, std::unordered_map<Key_t, Value_t>> or
             std::is_same_v<T, std::map<Key_t, Value_t>>,
@@ -180,40 +256,40 @@ namespace jluna
     unsafe::Value* box(const T& value)
     {
         static auto* new_dict = unsafe::get_function("jluna"_sym, "new_dict"_sym);
-        static auto* setindex = unsafe::get_function(jl_base_module, "setindex!"_sym);
 
-        gc_pause;
+        auto scope = detail::GCRootScope();
+        auto* keys = detail::gc_save(detail::box_as_array<Key_t>(value, [](auto& pair) -> const Key_t& {
+            return pair.first;
+        }));
 
-        auto* out = unsafe::call(new_dict, as_julia_type<Key_t>::type(), as_julia_type<Value_t>::type(), box((uint64_t) value.size()));
-        for (auto& pair : value)
-            safe_call(setindex, out, box<Value_t>(pair.second), box<Key_t>(pair.first));
+        auto* values = detail::gc_save(detail::box_as_array<Value_t>(value, [](auto& pair) -> const Value_t& {
+            return pair.second;
+        }));
 
-        gc_unpause;
-        return out;
+        return safe_call(new_dict, keys, values);
     }
 
     template<typename T, typename Value_t, std::enable_if_t<std::is_same_v<T, std::set<Value_t>>, bool>>
     unsafe::Value* box(const T& value)
     {
         static auto* new_set = unsafe::get_function("jluna"_sym, "new_set"_sym);
-        static auto* push = unsafe::get_function(jl_base_module, "push!"_sym);
 
-        gc_pause;
+        auto scope = detail::GCRootScope();
+        auto* values = detail::gc_save(detail::box_as_array<Value_t>(value, [](auto& e) -> const Value_t& {
+            return e;
+        }));
 
-        auto* out = unsafe::call(new_set, as_julia_type<Value_t>::type(), box((uint64_t) value.size()));
-
-        for (auto& e : value)
-            unsafe::call(push, out, box<Value_t>(e));
-
-        gc_unpause;
-        return out;
+        return safe_call(new_set, values);
     }
 
     template<typename T, typename T1, typename T2, std::enable_if_t<std::is_same_v<T, std::pair<T1, T2>>, bool>>
     unsafe::Value* box(const T& value)
     {
         static auto* pair = unsafe::get_function(jl_base_module, "Pair"_sym);
-        return unsafe::call(pair, box<T1>(value.first), box<T2>(value.second));
+        auto scope = detail::GCRootScope();
+        auto* first = detail::gc_save(box<T1>(value.first));
+        auto* second = box<T2>(value.second);
+        return unsafe::call(pair, first, second);
     }
 
     #ifdef _MSC_VER
@@ -225,10 +301,11 @@ namespace jluna
     template<is_tuple T>
     unsafe::Value* box(const T& value)
     {
-        gc_pause;
-
+        auto scope = detail::GCRootScope();
         auto* args_v = unsafe::new_array((unsafe::Value*) jl_any_type, std::tuple_size_v<T>);
+        detail::gc_push(args_v);
         auto* args_t = unsafe::new_array((unsafe::Value*) jl_type_type, std::tuple_size_v<T>);
+        detail::gc_push(args_t);
 
         {
             uint64_t i = 0;
@@ -248,7 +325,6 @@ namespace jluna
             auto* out = jl_new_structv(tuple_t, (jl_value_t**) args_v->data, args_v->length);
         #endif
 
-        gc_unpause;
         return out;
     }
 
@@ -2,6 +2,7 @@
 
 #include <include/julia_wrapper.hpp>
 #include <include/cppcall.hpp>
+#include <.src/task_pool.hpp>
 
 #include <iostream>
 #include <thread>
@@ -27,6 +28,8 @@ void jluna_free_lambda(void* in, int n_args)
         delete (jluna::detail::lambda_2_arg*) in;
     else if (n_args == 3)
         delete (jluna::detail::lambda_3_arg*) in;
+    else if (n_args > 3)
+        delete (jluna::detail::lambda_n_arg*) in;
     else
         std::cerr << "[C++][WARNING] In c_adapter::jluna_free_lambda: Unreachable reached" << std::endl;
 }
@@ -51,6 +54,11 @@ jluna::unsafe::Value* jluna_invoke_lambda_3(void* function_ptr, jluna::unsafe::V
     return (*reinterpret_cast<jluna::detail::lambda_3_arg*>(function_ptr))(x, y, z);
 }
 
+jluna::unsafe::Value* jluna_invoke_lambda_n(void* function_ptr, jluna::unsafe::Value** args, uint64_t)
+{
+    return (*reinterpret_cast<jluna::detail::lambda_n_arg*>(function_ptr))(args);
+}
+
 void* jluna_to_pointer(jl_value_t* in)
 {
     return (void*) in;
@@ -58,9 +66,23 @@ void* jluna_to_pointer(jl_value_t* in)
 
 uint64_t jluna_invoke_from_task(uint64_t function_ptr)
 {
-    return reinterpret_cast<uint64_t>(
-        (*reinterpret_cast<std::function<jluna::unsafe::Value*()>*>(function_ptr))()
-    );
+    auto* function = reinterpret_cast<jluna::detail::TaskFunction*>(function_ptr);
+    auto* out = (*function)();
+
+    // finishing may release the task, which calls into Julia, so the result stays rooted until it was handed back
+    auto scope = jluna::detail::GCRootScope();
+    jluna::detail::gc_push(out);
+
+    try
+    {
+        function->finish();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[C++][WARNING] In c_adapter::jluna_invoke_from_task: failed to release task: " << e.what() << std::endl;
+    }
+
+    return reinterpret_cast<uint64_t>(out);
 }
 
 bool jluna_verify()
@@ -19,12 +19,12 @@ extern "C"
         using lambda_1_arg = std::function<jl_value_t *(jl_value_t *)>;
         using lambda_2_arg = std::function<jl_value_t *(jl_value_t *, jl_value_t *)>;
         using lambda_3_arg = std::function<jl_value_t *(jl_value_t *, jl_value_t *, jl_value_t *)>;
-        //using lambda_n_arg = std::function<jl_value_t*(const std::vector<jl_value_t*>&)>;
+        using lambda_n_arg = std::function<jl_value_t *(jl_value_t **)>;
     }
 
     /// @brief construct an UnnamedFunctionProxy object
     /// @param function_ptr: allocated with `new`
-    /// @param n_args: number of arguments: 0, 1, 2, 3 or -1
+    /// @param n_args: number of arguments, if larger than 3, function_ptr has to point to a lambda_n_arg
     /// @returns ptr to UnnamedFunctionProxy object
     jl_value_t* jluna_make(void* function_ptr, int n_args);
 
@@ -33,16 +33,23 @@ extern "C"
     jl_value_t* jluna_invoke_lambda_2(void* function_ptr, jl_value_t*,  jl_value_t*);
     jl_value_t* jluna_invoke_lambda_3(void* function_ptr, jl_value_t*,  jl_value_t*, jl_value_t*);
 
+    /// @brief invoke function with more than 3 arguments
+    /// @param function_ptr: pointer to lambda_n_arg
+    /// @param args: pointer to first argument, points to a Julia-side NTuple{n_args, Any}
+    /// @param n_args: number of arguments
+    /// @returns result pointer
+    jl_value_t* jluna_invoke_lambda_n(void* function_ptr, jl_value_t** args, uint64_t n_args);
+
     /// @brief `delete` a function pointer held
     /// @param pointer to function
-    /// @param n_args: 0, 1, 2, 3 or -1
+    /// @param n_args: number of arguments of the function
     void jluna_free_lambda(void* function_ptr, int n_args);
 
     /// @brief get pointer to arbitrary object
     void* jluna_to_pointer(jl_value_t*);
 
     /// @brief invoke function ptr, used within threadpool
-    /// @param function_pointer
+    /// @param function_pointer: pointer to detail::TaskFunction
     /// @returns result pointer
     uint64_t jluna_invoke_from_task(uint64_t function_ptr);
 
@@ -19,9 +19,59 @@
 
 namespace jluna
 {
+    namespace detail
+    {
+        // signatures that can be called Julia-side through a typed ccall, arguments and result are passed by value
+        template<typename Return_t, typename... Args_t>
+        constexpr bool is_typed_signature = is_ccall_compatible<Return_t> and ((is_ccall_compatible<Args_t> and not std::is_void_v<Args_t>) and ...);
+
+        template<typename Return_t, typename... Args_t>
+        Return_t invoke_typed_function(void* function_ptr, Args_t... args)
+        {
+            return (*reinterpret_cast<std::function<Return_t(Args_t...)>*>(function_ptr))(args...);
+        }
+
+        template<typename Return_t, typename... Args_t>
+        void free_typed_function(void* function_ptr)
+        {
+            delete reinterpret_cast<std::function<Return_t(Args_t...)>*>(function_ptr);
+        }
+
+        template<typename T>
+        unsafe::Value* as_ccall_type()
+        {
+            if constexpr (std::is_void_v<T>)
+                return (unsafe::Value*) jl_nothing_type;
+            else
+                return (unsafe::Value*) as_julia_type<T>::type();
+        }
+
+        template<typename Return_t, typename... Args_t>
+        unsafe::Value* register_typed_function(std::function<Return_t(Args_t...)> f)
+        {
+            static auto* make = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "make_typed_unnamed_function"_sym);
+
+            auto* function_ptr = new std::function<Return_t(Args_t...)>(std::move(f));
+            auto* invoke_ptr = reinterpret_cast<void*>(&invoke_typed_function<Return_t, Args_t...>);
+            auto* free_ptr = reinterpret_cast<void*>(&free_typed_function<Return_t, Args_t...>);
+
+            auto scope = detail::GCRootScope();
+            return safe_call(make,
+                gc_save(jl_box_voidpointer(function_ptr)),
+                gc_save(jl_box_voidpointer(invoke_ptr)),
+                gc_save(jl_box_voidpointer(free_ptr)),
+                as_ccall_type<Return_t>(),
+                as_ccall_type<Args_t>()...
+            );
+        }
+    }
+
     template<typename Return_t>
     unsafe::Value* register_function(std::function<Return_t()> f)
     {
+        if constexpr (detail::is_typed_signature<Return_t>)
+            return detail::register_typed_function(f);
+
         auto* out = new detail::lambda_0_arg([f]() -> unsafe::Value*
         {
             return box_function_result(f);
@@ -33,6 +83,9 @@ namespace jluna
     template<typename Return_t, typename Arg1_t>
     unsafe::Value* register_function(std::function<Return_t(Arg1_t)> f)
     {
+        if constexpr (detail::is_typed_signature<Return_t, Arg1_t>)
+            return detail::register_typed_function(f);
+
         auto* out = new detail::lambda_1_arg([f](unsafe::Value* arg1)
         {
             return box_function_result(f, unbox<Arg1_t>(arg1));
@@ -44,6 +97,9 @@ namespace jluna
     template<typename Return_t, typename Arg1_t, typename Arg2_t>
     unsafe::Value* register_function(std::function<Return_t(Arg1_t, Arg2_t)> f)
     {
+        if constexpr (detail::is_typed_signature<Return_t, Arg1_t, Arg2_t>)
+            return detail::register_typed_function(f);
+
         auto* out = new detail::lambda_2_arg([f](unsafe::Value* arg1, unsafe::Value* arg2)
         {
             return box_function_result(f, unbox<Arg1_t>(arg1), unbox<Arg2_t>(arg2));
@@ -55,6 +111,9 @@ namespace jluna
     template<typename Return_t, typename Arg1_t, typename Arg2_t, typename Arg3_t>
     unsafe::Value* register_function(std::function<Return_t(Arg1_t, Arg2_t, Arg3_t)> f)
     {
+        if constexpr (detail::is_typed_signature<Return_t, Arg1_t, Arg2_t, Arg3_t>)
+            return detail::register_typed_function(f);
+
         auto* out = new detail::lambda_3_arg([f](unsafe::Value* arg1, unsafe::Value* arg2, unsafe::Value* arg3)
         {
             return box_function_result(f, unbox<Arg1_t>(arg1), unbox<Arg2_t>(arg2), unbox<Arg3_t>(arg3));
@@ -63,6 +122,22 @@ namespace jluna
         return jluna_make(out, 3);
     }
 
+    template<typename Return_t, typename... Args_t, std::enable_if_t<(sizeof...(Args_t) > 3), bool>>
+    unsafe::Value* register_function(std::function<Return_t(Args_t...)> f)
+    {
+        if constexpr (detail::is_typed_signature<Return_t, Args_t...>)
+            return detail::register_typed_function(f);
+
+        auto* out = new detail::lambda_n_arg([f](unsafe::Value** args)
+        {
+            return [&]<uint64_t... Is>(std::index_sequence<Is...>) {
+                return box_function_result(f, unbox<Args_t>(args[Is])...);
+            }(std::index_sequence_for<Args_t...>{});
+        });
+
+        return jluna_make(out, sizeof...(Args_t));
+    }
+
     template<typename Function_t, typename _>
     unsafe::Value* as_julia_function(_ lambda)
     {
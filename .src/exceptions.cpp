@@ -9,16 +9,91 @@
 #include <sstream>
 #include <vector>
 #include <iostream>
+#include <mutex>
 
 namespace jluna
 {
+    struct JuliaException::LazyMessage
+    {
+        // exception has to be rooted by the caller until the ctor returned
+        LazyMessage(unsafe::Value* exception)
+            : _exception(exception), _exception_id(unsafe::gc_preserve(exception))
+        {
+            release_deferred();
+        }
+
+        ~LazyMessage()
+        {
+            // copies of the exception may be destroyed on a thread not known to Julia, their release is deferred until the next exception on a Julia thread
+            if (not detail::is_julia_thread())
+            {
+                std::lock_guard<std::mutex> lock(_deferred_lock);
+                _deferred.push_back(_exception_id);
+                return;
+            }
+
+            unsafe::gc_release(_exception_id);
+            release_deferred();
+        }
+
+        static void release_deferred()
+        {
+            std::vector<uint64_t> to_release;
+            {
+                std::lock_guard<std::mutex> lock(_deferred_lock);
+                std::swap(to_release, _deferred);
+            }
+
+            for (auto id : to_release)
+                unsafe::gc_release(id);
+        }
+
+        void format()
+        {
+            static auto* format_exception = unsafe::get_function("jluna"_sym, "format_exception"_sym);
+
+            auto* formatted = jl_call1(format_exception, _exception);
+            if (formatted != nullptr)
+                _message = "[JULIA][EXCEPTION] " + std::string(jl_string_ptr(formatted));
+            else
+                _message = "[JULIA][EXCEPTION] " + std::string(jl_typeof_str(_exception));
+        }
+
+        unsafe::Value* _exception;
+        uint64_t _exception_id;
+
+        std::once_flag _formatted;
+        std::string _message;
+
+        static inline std::mutex _deferred_lock = std::mutex();
+        static inline std::vector<uint64_t> _deferred = {};
+    };
+
     JuliaException::JuliaException(jl_value_t* exception, const std::string& stacktrace)
         : _value(exception), _message("[JULIA][EXCEPTION] " + stacktrace)
     {}
 
+    JuliaException::JuliaException(jl_value_t* exception)
+        : _lazy_message(std::make_shared<LazyMessage>(exception))
+    {
+        static auto* caught_exception_type = unsafe::get_value("jluna"_sym, "CaughtException"_sym);
+
+        if (jl_typeof(exception) == caught_exception_type)
+            _value = jl_get_nth_field(exception, 0);
+        else
+            _value = exception;
+    }
+
     const char* JuliaException::what() const noexcept
     {
-        return _message.c_str();
+        if (_lazy_message == nullptr)
+            return _message.c_str();
+
+        std::call_once(_lazy_message->_formatted, [&](){
+            _lazy_message->format();
+        });
+
+        return _lazy_message->_message.c_str();
     }
 
     JuliaException::operator unsafe::Value*()
@@ -0,0 +1,166 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#include <include/safe_utilities.hpp>
+#include <.src/gc_sentinel.hpp>
+
+#include <iostream>
+
+namespace jluna
+{
+    template<typename Return_t, typename... Args_t>
+    Function<Return_t(Args_t...)>::Function(unsafe::Value* function)
+        : _value(function), _value_id(unsafe::gc_preserve(function))
+    {
+        if constexpr (detail::is_typed_signature<Return_t, Args_t...>)
+        {
+            static auto* make_key = unsafe::get_function("jluna"_sym, "compiled_function_key"_sym);
+            static auto* compile_function = unsafe::get_function("jluna"_sym, "compile_function"_sym);
+
+            // the key is computed once and stays rooted, so the deleter does not need to allocate
+            auto scope = detail::GCRootScope();
+            auto* key = detail::gc_save(jluna::safe_call(
+                make_key,
+                _value,
+                detail::as_ccall_type<Return_t>(),
+                detail::as_ccall_type<Args_t>()...
+            ));
+
+            auto* compiled = reinterpret_cast<void*>(jl_unbox_uint64(jluna::safe_call(compile_function, key)));
+
+            // compilation failed, fall back to calling dynamically
+            if (compiled == nullptr)
+                return;
+
+            // the cache entry references the function, so it stays valid until the deleter runs
+            _compiled = std::shared_ptr<void>(compiled, [key, key_id = unsafe::gc_preserve(key)](void*) {
+
+                // the Julia state may already be shut down, or the last handle may be destroyed on a thread not known to Julia. The cache entry is kept in that case
+                if (not detail::is_julia_thread())
+                    return;
+
+                try
+                {
+                    static auto* release_function = unsafe::get_function("jluna"_sym, "release_function"_sym);
+                    jluna::safe_call(release_function, key);
+                    unsafe::gc_release(key_id);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "[C++][WARNING] In jluna::Function: failed to release compiled function: " << e.what() << std::endl;
+                }
+            });
+        }
+    }
+
+    template<typename Return_t, typename... Args_t>
+    Function<Return_t(Args_t...)>::Function(Proxy proxy)
+        : Function(static_cast<unsafe::Value*>(proxy))
+    {}
+
+    template<typename Return_t, typename... Args_t>
+    Function<Return_t(Args_t...)>::~Function()
+    {
+        if (_value != nullptr)
+            unsafe::gc_release(_value_id);
+    }
+
+    template<typename Return_t, typename... Args_t>
+    Function<Return_t(Args_t...)>::Function(const Function& other)
+        : _value(other._value), _value_id(unsafe::gc_preserve(other._value)), _compiled(other._compiled)
+    {}
+
+    template<typename Return_t, typename... Args_t>
+    Function<Return_t(Args_t...)>::Function(Function&& other) noexcept
+        : _value(other._value), _value_id(other._value_id), _compiled(std::move(other._compiled))
+    {
+        other._value = nullptr;
+    }
+
+    template<typename Return_t, typename... Args_t>
+    Function<Return_t(Args_t...)>& Function<Return_t(Args_t...)>::operator=(const Function& other)
+    {
+        if (&other == this)
+            return *this;
+
+        auto* value = other._value;
+        auto value_id = unsafe::gc_preserve(value);
+
+        if (_value != nullptr)
+            unsafe::gc_release(_value_id);
+
+        _value = value;
+        _value_id = value_id;
+        _compiled = other._compiled;
+        return *this;
+    }
+
+    template<typename Return_t, typename... Args_t>
+    Function<Return_t(Args_t...)>& Function<Return_t(Args_t...)>::operator=(Function&& other) noexcept
+    {
+        if (&other == this)
+            return *this;
+
+        if (_value != nullptr)
+            unsafe::gc_release(_value_id);
+
+        _value = other._value;
+        _value_id = other._value_id;
+        _compiled = std::move(other._compiled);
+        other._value = nullptr;
+        return *this;
+    }
+
+    template<typename Return_t, typename... Args_t>
+    Return_t Function<Return_t(Args_t...)>::operator()(Args_t... args) const
+    {
+        throw_if_uninitialized();
+
+        if constexpr (detail::is_typed_signature<Return_t, Args_t...>)
+        {
+            if (_compiled != nullptr)
+            {
+                using Result_t = std::conditional_t<std::is_void_v<Return_t>, char, Return_t>;
+                struct Frame
+                {
+                    Return_t (*function)(Args_t...);
+                    std::tuple<Args_t...> args;
+                    Result_t result;
+                };
+
+                auto frame = Frame{reinterpret_cast<Return_t(*)(Args_t...)>(_compiled.get()), {args...}, Result_t()};
+                detail::safe_invoke_aux([](void* data) {
+                    auto* frame = static_cast<Frame*>(data);
+                    if constexpr (std::is_void_v<Return_t>)
+                        std::apply(frame->function, frame->args);
+                    else
+                        frame->result = std::apply(frame->function, frame->args);
+                }, &frame);
+
+                if constexpr (std::is_void_v<Return_t>)
+                    return;
+                else
+                    return frame.result;
+            }
+        }
+
+        // arguments stay rooted while the remaining ones are boxed, the buffer lives on the stack so concurrent calls do not share it
+        auto scope = detail::GCRootScope();
+        std::array<unsafe::Value*, sizeof...(Args_t) + 1> buffer = {
+            _value,
+            detail::gc_save(box<std::decay_t<Args_t>>(args))...
+        };
+
+        auto* result = detail::safe_call_aux(buffer.data(), buffer.size());
+
+        if constexpr (not std::is_void_v<Return_t>)
+            return unbox<Return_t>(detail::gc_save(result));
+    }
+
+    template<typename Return_t, typename... Args_t>
+    Function<Return_t(Args_t...)>::operator unsafe::Value*() const
+    {
+        return _value;
+    }
+}
@@ -7,38 +7,172 @@
 
 #include <include/concepts.hpp>
 
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
 namespace jluna::detail
 {
-    template<is_julia_value_pointer... Ts>
-    inline void gc_push(Ts... ts)
+    /// @brief check if the Julia C-API may be used from the calling thread
+    /// @returns false if the Julia state is not initialized or the thread was not started or adopted by Julia, true otherwise
+    inline bool is_julia_thread()
+    {
+        return jl_is_initialized() and jl_get_pgcstack() != nullptr;
+    }
+
+    /// @brief per-task stack of values that are treated as roots by the Julia GC
+    /// @note the stack belongs to the Julia task, not the C++ thread, so values stay rooted if a task yields and resumes on a different thread. It is returned to a free list once the task has finished
+    class GCRootStack
+    {
+        public:
+            /// @brief ctor
+            GCRootStack()
+            {
+                _values.reserve(64);
+            }
+
+            /// @brief add value
+            /// @param value
+            void push(unsafe::Value* value)
+            {
+                _values.push_back(value);
+            }
+
+            /// @brief remove last n values, if present
+            /// @param n
+            void pop(uint64_t n)
+            {
+                _values.resize(_values.size() > n ? _values.size() - n : 0);
+            }
+
+            /// @brief get number of values
+            /// @returns size
+            uint64_t size() const
+            {
+                return _values.size();
+            }
+
+            /// @brief truncate stack to specified size
+            /// @param size
+            void truncate(uint64_t size)
+            {
+                if (size < _values.size())
+                    _values.resize(size);
+            }
+
+            /// @brief get stack of the current task, assigning one to the task if necessary
+            /// @returns reference to stack
+            static GCRootStack& current()
+            {
+                // stacks are never deallocated, only handed to a different task, so the cached pointer is always safe to dereference and only its owner needs to be checked
+                thread_local jl_task_t* cached_task = nullptr;
+                thread_local GCRootStack* cached_stack = nullptr;
+
+                auto* task = jl_current_task;
+                if (task == cached_task and cached_stack->_owner.load(std::memory_order_acquire) == task)
+                    return *cached_stack;
+
+                std::lock_guard<std::mutex> guard(_registry_lock);
+                auto& stack = _registry[task];
+                if (stack == nullptr)
+                {
+                    if (_free.empty())
+                        stack = new GCRootStack();
+                    else
+                    {
+                        stack = _free.back();
+                        _free.pop_back();
+                    }
+
+                    stack->_owner.store(task, std::memory_order_release);
+                }
+
+                cached_task = task;
+                cached_stack = stack;
+                return *cached_stack;
+            }
+
+            /// @brief mark all values of all stacks, registered as jl_gc_cb_root_scanner_t during jluna::initialize
+            /// @param full: unused
+            static void mark_all(int)
+            {
+                // all threads are stopped at a safepoint during collection, so a finished task cannot be using its stack anymore. Each task is kept alive until then by marking it here, so its address cannot be reused while it is still registered
+                std::lock_guard<std::mutex> guard(_registry_lock);
+                auto ptls = jl_current_task->ptls;
+
+                for (auto it = _registry.begin(); it != _registry.end();)
+                {
+                    auto* task = it->first;
+                    auto* stack = it->second;
+
+                    if (jl_atomic_load_relaxed(&task->_state) != JL_TASK_STATE_RUNNABLE)
+                    {
+                        stack->_values.clear();
+                        stack->_owner.store(nullptr, std::memory_order_release);
+                        _free.push_back(stack);
+                        it = _registry.erase(it);
+                        continue;
+                    }
+
+                    jl_gc_mark_queue_obj(ptls, (unsafe::Value*) task);
+                    for (auto* value : stack->_values)
+                        if (value != nullptr)
+                            jl_gc_mark_queue_obj(ptls, value);
+
+                    it++;
+                }
+            }
+
+        private:
+            std::vector<unsafe::Value*> _values;
+            std::atomic<jl_task_t*> _owner = nullptr;
+
+            static inline std::mutex _registry_lock = std::mutex();
+            static inline std::unordered_map<jl_task_t*, GCRootStack*> _registry = {};
+            static inline std::vector<GCRootStack*> _free = {};
+    };
+
+    /// @brief root stack of current task
+    /// @returns reference to stack
+    inline GCRootStack& gc_root_stack()
     {
-        static unsafe::Function* gc_push = nullptr;
+        return GCRootStack::current();
+    }
+
+    /// @brief RAII guard, restores the root stack to its size at construction on destruction, also if an exception occurred
+    class GCRootScope
+    {
+        public:
+            /// @brief ctor, remembers current size
+            GCRootScope()
+                : _stack(gc_root_stack()), _size(_stack.size())
+            {}
+
+            /// @brief dtor, pops all values pushed since construction
+            ~GCRootScope()
+            {
+                _stack.truncate(_size);
+            }
 
-        if (gc_push == nullptr)
-        {
-            bool before = jl_gc_is_enabled();
-            jl_gc_enable(false);
-            gc_push = jl_eval_string("return jluna.gc_sentinel.gc_push");
-            jl_gc_enable(true);
-        }
+            GCRootScope(const GCRootScope&) = delete;
+            GCRootScope& operator=(const GCRootScope&) = delete;
 
-        (jl_call1(gc_push, jl_box_voidpointer((void*) ts)), ...);
+        private:
+            GCRootStack& _stack;
+            uint64_t _size;
+    };
+
+    template<is_julia_value_pointer... Ts>
+    inline void gc_push(Ts... ts)
+    {
+        auto& stack = gc_root_stack();
+        (stack.push((unsafe::Value*) ts), ...);
     }
 
     inline void gc_pop(uint64_t n = 1)
     {
-        static unsafe::Function* gc_pop = nullptr;
-
-        if (gc_pop == nullptr)
-        {
-            bool before = jl_gc_is_enabled();
-            jl_gc_enable(false);
-            gc_pop = jl_eval_string("return jluna.gc_sentinel.gc_pop");
-            jl_gc_enable(true);
-        }
-
-        for (uint64_t i = 0; i < n; ++i)
-            jl_call0(gc_pop);
+        gc_root_stack().pop(n);
     }
 
     inline unsafe::Value* gc_save(unsafe::Value* in)
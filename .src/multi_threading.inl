@@ -7,6 +7,21 @@ namespace jluna
 {
     namespace detail
     {
+        // keeps all Julia-side tasks created by one ThreadPool::create_batch call alive, released once the last of them is freed
+        struct TaskBatchRoot
+        {
+            explicit TaskBatchRoot(unsafe::Value* tasks)
+                : _value_id(unsafe::gc_preserve(tasks))
+            {}
+
+            ~TaskBatchRoot()
+            {
+                unsafe::gc_release(_value_id);
+            }
+
+            uint64_t _value_id;
+        };
+
         template<typename Result_t>
         struct TaskValue : public detail::TaskSuper
         {
@@ -15,83 +30,324 @@ namespace jluna
             ~TaskValue();
 
             void free() override;
-            void initialize(std::function<unsafe::Value*()>*);
+            void initialize(TaskFunction*);
+            void initialize(unsafe::Value* task, std::shared_ptr<TaskBatchRoot> batch);
 
             unsafe::Value* _value = nullptr;
             uint64_t _value_id = -1;
+            std::shared_ptr<TaskBatchRoot> _batch = nullptr;
             uint64_t _threadpool_id = -1;
-            std::unique_ptr<Future<Result_t>> _future;
+            Future<Result_t> _future;
         };
     }
 
     template<typename T>
     Future<T>::Future()
-        : _mutex(), _cv_lock(), _cv()
+        : _mutex(), _cv()
     {}
 
     template<typename T>
     std::optional<T> Future<T>::get()
     {
-        std::optional<T> out;
-        _mutex.lock();
-        if (_value != nullptr)
-            out = std::optional<T>(*(_value.get()));
-        _mutex.unlock();
-        return out;
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _value;
     }
 
     template<typename T>
     bool Future<T>::is_available()
     {
-        bool out = false;
-        _mutex.lock();
-        if (_value != nullptr)
-            out = true;
-        _mutex.unlock();
-        return out;
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _value.has_value();
     }
 
     template<typename T>
     std::optional<T> Future<T>::wait()
     {
-        _cv.wait(_cv_lock, [&](){
-            return _value.get() != nullptr;
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [&](){
+            return _is_set;
         });
-        return get();
+        return _value;
     }
 
     namespace detail
     {
+        struct ContinuationOwner;
+
         struct FutureHandler
         {
             template<typename T>
-            static inline void update_future(Future<T>& future, T value)
+            static inline void update_future(Future<T>& future, T&& value)
+            {
+                future.set_value(std::move(value));
+            }
+
+            template<typename T>
+            static inline void fail_future(Future<T>& future)
             {
-                future.set_value(value);
+                future.set_failed();
+            }
+
+            // copies the value for a continuation. Move-only values are moved instead, .get and .wait of their future cannot be used anyway
+            template<typename T>
+            static inline std::optional<T> forward_value(std::optional<T>& value)
+            {
+                if constexpr (std::is_copy_constructible_v<T>)
+                    return value;
+                else
+                    return std::move(value);
+            }
+
+            template<typename T>
+            static inline void attach(Future<T>& future, typename Future<T>::Continuation&& continuation)
+            {
+                future.set_continuation(std::move(continuation));
+            }
+
+            template<typename Return_t, typename Lambda_t>
+            static inline Task<Return_t> create_task(Lambda_t&& lambda)
+            {
+                return ThreadPool::create_task<Return_t>(std::forward<Lambda_t>(lambda));
+            }
+
+            template<typename T>
+            static inline std::shared_ptr<ContinuationOwner> own(Task<T>& task)
+            {
+                return std::make_shared<ContinuationOwner>(task._value->_threadpool_id, task._value->_value);
+            }
+
+            static inline void retain(uint64_t threadpool_id)
+            {
+                ThreadPool::retain(threadpool_id);
+            }
+
+            static inline void release(uint64_t threadpool_id)
+            {
+                ThreadPool::free(threadpool_id);
+            }
+
+            static inline void release_after_run(uint64_t threadpool_id)
+            {
+                ThreadPool::_pool.at(threadpool_id).function.set_on_finish(&ThreadPool::free, threadpool_id);
             }
         };
+
+        // keeps the task of a continuation alive until it ran, its jluna::Task may go out of scope before
+        struct ContinuationOwner
+        {
+            ContinuationOwner(uint64_t threadpool_id, unsafe::Value* task)
+                : _threadpool_id(threadpool_id), _task(task)
+            {
+                FutureHandler::retain(_threadpool_id);
+            }
+
+            ~ContinuationOwner()
+            {
+                if (_task != nullptr)
+                    FutureHandler::release(_threadpool_id);
+            }
+
+            // ownership is handed over to the run of the task, returns the Julia-side task to schedule
+            unsafe::Value* hand_over()
+            {
+                auto* out = _task;
+                _task = nullptr;
+                FutureHandler::release_after_run(_threadpool_id);
+                return out;
+            }
+
+            uint64_t _threadpool_id;
+            unsafe::Value* _task;
+        };
+
+        inline void schedule_continuation(unsafe::Value* task)
+        {
+            if (task == nullptr)
+                return;
+
+            static auto* schedule = unsafe::get_function(jl_base_module, "schedule"_sym);
+            jluna::safe_call(schedule, task);
+        }
+    }
+
+    template<typename T>
+    void Future<T>::set_value(T&& value)
+    {
+        set(std::optional<T>(std::move(value)));
     }
 
     template<typename T>
-    void Future<T>::set_value(T value)
+    void Future<T>::set_failed()
     {
+        set(std::nullopt);
+    }
+
+    template<typename T>
+    void Future<T>::set(std::optional<T>&& value)
+    {
+        unsafe::Value* to_schedule = nullptr;
+
         _mutex.lock();
-        _value = std::make_unique<T>(value);
+        _value = std::move(value);
+        _is_set = true;
+
+        if (_continuation)
+        {
+            to_schedule = _continuation(_value);
+            _continuation = nullptr;
+        }
+
         _cv.notify_all();
         _mutex.unlock();
+
+        detail::schedule_continuation(to_schedule);
+    }
+
+    template<typename T>
+    void Future<T>::set_continuation(Continuation&& continuation)
+    {
+        unsafe::Value* to_schedule = nullptr;
+
+        _mutex.lock();
+        if (_has_continuation)
+        {
+            _mutex.unlock();
+            throw std::invalid_argument("In jluna::Future: future already has a continuation attached, only one of then, when_all or when_any can be used per future");
+        }
+
+        _has_continuation = true;
+
+        if (_is_set)
+            to_schedule = continuation(_value);
+        else
+            _continuation = std::move(continuation);
+
+        _mutex.unlock();
+
+        detail::schedule_continuation(to_schedule);
+    }
+
+    template<typename T>
+    template<typename Function_t, typename Return_t>
+    Task<Return_t> Future<T>::then(Function_t f)
+    {
+        auto input = std::make_shared<std::optional<T>>();
+
+        auto task = detail::FutureHandler::create_task<Return_t>([f = std::move(f), input]() mutable {
+            if (not input->has_value())
+                throw std::runtime_error("In jluna::Future::then: the task this continuation was attached to failed");
+
+            return f(std::move(input->value()));
+        });
+
+        auto owner = detail::FutureHandler::own(task);
+        set_continuation([input, owner](std::optional<T>& value) -> unsafe::Value* {
+            *input = detail::FutureHandler::forward_value(value);
+            return owner->hand_over();
+        });
+
+        return task;
+    }
+
+    template<typename... Ts>
+    Task<std::tuple<Ts...>> when_all(Future<Ts>&... futures)
+    {
+        static_assert(sizeof...(Ts) > 0, "In jluna::when_all: at least one future has to be specified");
+
+        struct State
+        {
+            std::tuple<std::optional<Ts>...> values;
+            std::atomic<uint64_t> n_remaining = sizeof...(Ts);
+            std::atomic<bool> any_failed = false;
+        };
+
+        auto state = std::make_shared<State>();
+
+        auto task = detail::FutureHandler::create_task<std::tuple<Ts...>>([state]() {
+            if (state->any_failed.load(std::memory_order_acquire))
+                throw std::runtime_error("In jluna::when_all: at least one of the tasks failed");
+
+            return std::apply([](auto&... values) {
+                return std::tuple<Ts...>(std::move(values.value())...);
+            }, state->values);
+        });
+
+        auto owner = detail::FutureHandler::own(task);
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (detail::FutureHandler::attach(futures, [state, owner](std::optional<Ts>& value) -> unsafe::Value* {
+                if (value.has_value())
+                    std::get<Is>(state->values) = detail::FutureHandler::forward_value(value);
+                else
+                    state->any_failed.store(true, std::memory_order_release);
+
+                // last future to finish schedules the task
+                return state->n_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 ? owner->hand_over() : nullptr;
+            }), ...);
+        }(std::index_sequence_for<Ts...>());
+
+        return task;
+    }
+
+    template<typename T, typename... Ts>
+    Task<std::pair<uint64_t, T>> when_any(Future<T>& first, Future<Ts>&... rest)
+    {
+        static_assert((std::is_same_v<T, Ts> and ...), "In jluna::when_any: all futures have to have the same value type");
+
+        struct State
+        {
+            std::optional<std::pair<uint64_t, T>> result;
+            std::atomic<bool> is_done = false;
+            std::atomic<uint64_t> n_failed = 0;
+        };
+
+        auto state = std::make_shared<State>();
+
+        auto task = detail::FutureHandler::create_task<std::pair<uint64_t, T>>([state]() {
+            if (not state->result.has_value())
+                throw std::runtime_error("In jluna::when_any: all of the tasks failed");
+
+            return std::move(state->result.value());
+        });
+
+        auto owner = detail::FutureHandler::own(task);
+        auto attach = [&](Future<T>& future, uint64_t index) {
+            detail::FutureHandler::attach(future, [state, owner, index](std::optional<T>& value) -> unsafe::Value* {
+
+                // the task is scheduled with the first value, or without one once all tasks failed
+                if (not value.has_value() and state->n_failed.fetch_add(1, std::memory_order_acq_rel) + 1 != 1 + sizeof...(Ts))
+                    return nullptr;
+
+                if (state->is_done.exchange(true, std::memory_order_acq_rel))
+                    return nullptr;
+
+                if (value.has_value())
+                    state->result.emplace(index, detail::FutureHandler::forward_value(value).value());
+
+                return owner->hand_over();
+            });
+        };
+
+        uint64_t index = 0;
+        attach(first, index++);
+        (attach(rest, index++), ...);
+
+        return task;
     }
 
     // ###
 
     template<typename T>
     detail::TaskValue<T>::TaskValue(uint64_t id)
-        : _threadpool_id(id), _future(std::make_unique<Future<T>>())
+        : _threadpool_id(id), _future()
     {}
 
     template<typename T>
     void detail::TaskValue<T>::free()
     {
-        unsafe::gc_release(_value_id);
+        if (_batch != nullptr)
+            _batch.reset();
+        else
+            unsafe::gc_release(_value_id);
     }
 
     template<typename T>
@@ -99,19 +355,20 @@ namespace jluna
     {}
 
     template<typename T>
-    void detail::TaskValue<T>::initialize(std::function<unsafe::Value*()>* in)
+    void detail::TaskValue<T>::initialize(TaskFunction* in)
     {
         static auto* make_task = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "make_task"_sym);
         _value = unsafe::call(make_task, box(reinterpret_cast<uint64_t>(in)));
-
-        static auto* setfield = unsafe::get_function(jl_base_module, "setfield!"_sym);
-        static auto* sticky = jl_symbol("sticky");
-
-        unsafe::call(setfield, _value, sticky, jl_box_bool(false));
-
         _value_id = unsafe::gc_preserve(_value);
     }
 
+    template<typename T>
+    void detail::TaskValue<T>::initialize(unsafe::Value* task, std::shared_ptr<TaskBatchRoot> batch)
+    {
+        _value = task;
+        _batch = std::move(batch);
+    }
+
     template<typename T>
     Task<T>::Task(detail::TaskValue<T>* ptr)
         : _value(ptr)
@@ -145,6 +402,7 @@ namespace jluna
     {
         _value = std::move(other._value);
         other._value = nullptr;
+        return *this;
     }
 
     template<typename T>
@@ -206,7 +464,7 @@ namespace jluna
             assert(this->_value != nullptr);
         }
 
-        return std::ref(*(_value->_future.get()));
+        return _value->_future;
     }
 
     // void specialization for nicer syntax
@@ -214,6 +472,7 @@ namespace jluna
     class Task<void>
     {
         friend class ThreadPool;
+        friend struct detail::FutureHandler;
 
         public:
             ~Task();
@@ -321,7 +580,7 @@ namespace jluna
             std::cerr << "[ERROR][C++] In Task<void>::result: trying to access the future of a task that is no longer valid. Tasks are invalidated when the move assignment operator or move constructor is called, which transfers a tasks internal state into the newly constructed one." << std::endl;
             assert(this->_value != nullptr);
         }
-        return std::ref(*(_value->_future.get()));
+        return _value->_future;
     }
 
     // ###
@@ -332,48 +591,159 @@ namespace jluna
         return ThreadPool::create(std::function<Signature>(f), args...);
     }
 
-    template<typename... Args_t>
-    Task<void> ThreadPool::create(const std::function<void(Args_t...)>& lambda, Args_t... args)
+    template<typename Return_t, typename Lambda_t>
+    auto* ThreadPool::allocate_task(Lambda_t&& lambda)
+    {
+        using Value_t = std::conditional_t<std::is_void_v<Return_t>, unsafe::Value*, Return_t>;
+
+        auto id = _pool.acquire();
+        auto& slot = _pool.at(id);
+
+        auto* task = slot.value.emplace<detail::TaskValue<Value_t>>(id);
+        slot.task = task;
+        slot.n_owners.store(1, std::memory_order_relaxed);
+        slot.function.emplace([lambda = std::forward<Lambda_t>(lambda), future = &task->_future]() mutable -> unsafe::Value* {
+
+            try
+            {
+                if constexpr (std::is_void_v<Return_t>)
+                {
+                    lambda();
+                    detail::FutureHandler::update_future<unsafe::Value*>(*future, static_cast<unsafe::Value*>(jl_nothing));
+                    return jl_nothing;
+                }
+                else
+                {
+                    auto res = lambda();
+
+                    // box before the value is moved into the future
+                    unsafe::Value* out = jl_nothing;
+                    if constexpr (is_boxable<Return_t>)
+                        out = box<Return_t>(res);
+
+                    detail::GCRootScope scope;
+                    detail::gc_push(out);
+                    detail::FutureHandler::update_future<Return_t>(*future, std::move(res));
+                    return out;
+                }
+            }
+            catch (...)
+            {
+                // exceptions cannot cross into Julia, the Julia-side task fails instead. Continuations are scheduled regardless
+                detail::FutureHandler::fail_future(*future);
+                return nullptr;
+            }
+        });
+
+        return task;
+    }
+
+    template<typename Return_t, typename Lambda_t>
+    Task<Return_t> ThreadPool::create_task(Lambda_t&& lambda)
+    {
+        auto* task = allocate_task<Return_t>(std::forward<Lambda_t>(lambda));
+        task->initialize(&_pool.at(task->_threadpool_id).function);
+        return Task<Return_t>(task);
+    }
+
+    template<typename Function_t, typename Return_t>
+    std::vector<Task<Return_t>> ThreadPool::create_batch(uint64_t n, Function_t f)
+    {
+        using Value_t = std::conditional_t<std::is_void_v<Return_t>, unsafe::Value*, Return_t>;
+
+        std::vector<detail::TaskValue<Value_t>*> values;
+        values.reserve(n);
+
+        std::vector<uint64_t> function_ptrs;
+        function_ptrs.reserve(n);
+
+        // function is shared, so each lambda stays small enough to be stored in-place
+        auto shared = std::make_shared<Function_t>(std::move(f));
+
+        std::vector<Task<Return_t>> out;
+        out.reserve(n);
+
+        try
+        {
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                auto* task = allocate_task<Return_t>([shared, i]() {
+                    return (*shared)(i);
+                });
+
+                values.push_back(task);
+                function_ptrs.push_back(reinterpret_cast<uint64_t>(&_pool.at(task->_threadpool_id).function));
+            }
+
+            if (n == 0)
+                return out;
+
+            static auto* make_tasks = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "make_tasks"_sym);
+
+            auto scope = detail::GCRootScope();
+            auto* ptrs = box<std::vector<uint64_t>>(function_ptrs);
+            detail::gc_push(ptrs);
+
+            auto* tasks = (unsafe::Array*) jluna::safe_call(make_tasks, ptrs);
+            auto batch = std::make_shared<detail::TaskBatchRoot>((unsafe::Value*) tasks);
+
+            for (uint64_t i = 0; i < n; ++i)
+            {
+                values.at(i)->initialize(jl_arrayref(tasks, i), batch);
+                out.push_back(Task<Return_t>(values.at(i)));
+            }
+        }
+        catch (...)
+        {
+            // no Julia-side task was attached yet, return the slots to the pool
+            for (auto* value : values)
+                discard(value->_threadpool_id);
+
+            throw;
+        }
+
+        return out;
+    }
+
+    template<typename Return_t>
+    void ThreadPool::schedule_batch(std::vector<Task<Return_t>>& tasks)
     {
-        _storage_lock.lock();
+        static auto* schedule_tasks = unsafe::get_function((unsafe::Module*) jl_eval_string("return jluna.cppcall"), "schedule_tasks"_sym);
+
+        uint64_t n = 0;
+        for (auto& task : tasks)
+            if (task._value != nullptr)
+                n += 1;
 
-        detail::TaskValue<unsafe::Value*>* task = new detail::TaskValue<unsafe::Value*>(_current_id);
-        _storage.emplace(_current_id,
-            std::make_pair(
-            task,
-            std::make_unique<std::function<unsafe::Value*()>>([lambda, task, future = std::ref(*(task->_future.get())) ,args...]() -> unsafe::Value* {
-                lambda(args...);
-                detail::FutureHandler::update_future<unsafe::Value*>(future, jl_nothing);
-                return jl_nothing;
-        })));
-        auto& it = _storage.find(_current_id)->second;
-        task->initialize(it.second.get());
+        if (n == 0)
+            return;
 
-        _current_id += 1;
-        _storage_lock.unlock();
-        return Task<void>(task);
+        auto scope = detail::GCRootScope();
+        auto* array = unsafe::new_array((unsafe::Value*) jl_any_type, n);
+        detail::gc_push(array);
+
+        uint64_t i = 0;
+        for (auto& task : tasks)
+            if (task._value != nullptr)
+                jl_arrayset(array, task._value->_value, i++);
+
+        jluna::safe_call(schedule_tasks, array);
+    }
+
+    template<typename... Args_t>
+    Task<void> ThreadPool::create(const std::function<void(Args_t...)>& lambda, Args_t... args)
+    {
+        return create_task<void>([lambda, args...]() {
+            lambda(args...);
+        });
     }
 
     template<is_not<void> Return_t, typename... Args_t>
     Task<Return_t> ThreadPool::create(const std::function<Return_t(Args_t...)>& lambda, Args_t... args)
     {
-        _storage_lock.lock();
-
-        detail::TaskValue<Return_t>* task = new detail::TaskValue<Return_t>(_current_id);
-        _storage.emplace(_current_id,
-            std::make_pair(
-            task,
-            std::make_unique<std::function<unsafe::Value*()>>([lambda, future = std::ref(*(task->_future.get())) ,args...]() -> unsafe::Value* {
-                auto res = lambda(args...);
-                detail::FutureHandler::update_future<Return_t>(future, res);
-                return box<Return_t>(res);
-        })));
-        auto& it = _storage.find(_current_id)->second;
-        task->initialize(it.second.get());
-
-        _current_id += 1;
-        _storage_lock.unlock();
-        return Task<Return_t>(task);
+        return create_task<Return_t>([lambda, args...]() -> Return_t {
+            return lambda(args...);
+        });
     }
 
     inline uint64_t ThreadPool::n_threads()
@@ -388,15 +758,31 @@ namespace jluna
         return unbox<Int64>(jl_call0(threadid));
     }
 
+    inline void ThreadPool::retain(uint64_t id)
+    {
+        _pool.at(id).n_owners.fetch_add(1, std::memory_order_relaxed);
+    }
+
     inline void ThreadPool::free(uint64_t id)
     {
-        _storage_lock.lock();
-        auto it = _storage.find(id);
-        auto* ptr = it->second.first;
-        ptr->free();
-        delete it->second.first;
-        _storage.erase(id);
-        _storage_lock.unlock();
+        auto& slot = _pool.at(id);
+        if (slot.n_owners.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        slot.task->free();
+        slot.task = nullptr;
+        slot.value.reset();
+        slot.function.reset();
+        _pool.release(id);
+    }
+
+    inline void ThreadPool::discard(uint64_t id)
+    {
+        auto& slot = _pool.at(id);
+        slot.task = nullptr;
+        slot.value.reset();
+        slot.function.reset();
+        _pool.release(id);
     }
 
     // ###
@@ -0,0 +1,214 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#include <atomic>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace jluna
+{
+    namespace detail
+    {
+        // range of grains [begin, end) owned by one worker, packed as begin << 32 | end so it can be modified with a single CAS
+        struct alignas(64) WorkRange
+        {
+            std::atomic<uint64_t> range = 0;
+        };
+
+        inline uint64_t pack_work_range(uint64_t begin, uint64_t end)
+        {
+            return (begin << 32) | end;
+        }
+
+        // take first grain of own range
+        inline bool pop_front_work(WorkRange& own, uint64_t& grain)
+        {
+            uint64_t current = own.range.load(std::memory_order_acquire);
+            while (true)
+            {
+                uint64_t begin = current >> 32;
+                uint64_t end = current & 0xFFFFFFFF;
+
+                if (begin >= end)
+                    return false;
+
+                if (own.range.compare_exchange_weak(current, pack_work_range(begin + 1, end), std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    grain = begin;
+                    return true;
+                }
+            }
+        }
+
+        // take back half of another workers range
+        inline bool steal_work(WorkRange& victim, uint64_t& begin_out, uint64_t& end_out)
+        {
+            uint64_t current = victim.range.load(std::memory_order_acquire);
+            while (true)
+            {
+                uint64_t begin = current >> 32;
+                uint64_t end = current & 0xFFFFFFFF;
+
+                if (begin >= end)
+                    return false;
+
+                uint64_t mid = begin + (end - begin) / 2;
+                if (victim.range.compare_exchange_weak(current, pack_work_range(begin, mid), std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    begin_out = mid;
+                    end_out = end;
+                    return true;
+                }
+            }
+        }
+
+        // invoke f(begin, end, worker_index) for consecutive sub-ranges of [0, n), until all of [0, n) was processed
+        template<typename Function_t>
+        void parallel_for_ranges(uint64_t n, uint64_t grain_size, Function_t f)
+        {
+            if (n == 0)
+                return;
+
+            const uint64_t n_threads = ThreadPool::n_threads();
+
+            if (grain_size == 0)
+                grain_size = std::max<uint64_t>(1, n / (n_threads * 16));
+
+            // number of grains has to fit into 32 bit
+            grain_size = std::max<uint64_t>(grain_size, (n / 0xFFFFFFFF) + 1);
+
+            const uint64_t n_grains = (n + grain_size - 1) / grain_size;
+            const uint64_t n_workers = std::min<uint64_t>(n_threads, n_grains);
+
+            if (n_workers <= 1)
+            {
+                f(0, n, 0);
+                return;
+            }
+
+            std::vector<WorkRange> ranges(n_workers);
+            for (uint64_t i = 0; i < n_workers; ++i)
+                ranges.at(i).range.store(pack_work_range((n_grains * i) / n_workers, (n_grains * (i + 1)) / n_workers));
+
+            auto work = [&](uint64_t worker_i)
+            {
+                auto& own = ranges.at(worker_i);
+                uint64_t grain;
+
+                while (true)
+                {
+                    while (pop_front_work(own, grain))
+                    {
+                        uint64_t begin = grain * grain_size;
+                        f(begin, std::min(begin + grain_size, n), worker_i);
+                    }
+
+                    bool stolen = false;
+                    for (uint64_t offset = 1; offset < n_workers and not stolen; ++offset)
+                    {
+                        uint64_t begin, end;
+                        if (steal_work(ranges.at((worker_i + offset) % n_workers), begin, end))
+                        {
+                            own.range.store(pack_work_range(begin, end), std::memory_order_release);
+                            stolen = true;
+                        }
+                    }
+
+                    // all ranges were empty, remaining grains are in progress on other workers
+                    if (not stolen)
+                        return;
+                }
+            };
+
+            auto tasks = ThreadPool::create_batch(n_workers - 1, [&work](uint64_t i) {
+                work(i + 1);
+            });
+
+            ThreadPool::schedule_batch(tasks);
+
+            // calling thread participates as worker 0
+            work(0);
+
+            for (auto& task : tasks)
+                task.join();
+        }
+    }
+
+    template<typename Function_t, std::enable_if_t<std::is_invocable_v<Function_t, uint64_t>, bool>>
+    void parallel_for(uint64_t n, Function_t f, uint64_t grain_size)
+    {
+        detail::parallel_for_ranges(n, grain_size, [&](uint64_t begin, uint64_t end, uint64_t)
+        {
+            for (uint64_t i = begin; i < end; ++i)
+                f(i);
+        });
+    }
+
+    template<is_isbits_compatible Value_t, uint64_t Rank, typename Function_t>
+    void parallel_for(Array<Value_t, Rank>& array, Function_t f, uint64_t grain_size)
+    {
+        auto* data = detail::checked_array_data(array, "parallel_for");
+        auto n = static_cast<unsafe::Array*>(array)->length;
+
+        detail::parallel_for_ranges(n, grain_size, [&](uint64_t begin, uint64_t end, uint64_t)
+        {
+            for (uint64_t i = begin; i < end; ++i)
+                f(data[i]);
+        });
+    }
+
+    template<is_isbits_compatible In_t, is_isbits_compatible Out_t, uint64_t Rank, typename Function_t>
+    void parallel_transform(const Array<In_t, Rank>& in, Array<Out_t, Rank>& out, Function_t f, uint64_t grain_size)
+    {
+        const auto* in_data = detail::checked_array_data(in, "parallel_transform");
+        auto* out_data = detail::checked_array_data(out, "parallel_transform");
+
+        auto n = static_cast<unsafe::Array*>(in)->length;
+        if (static_cast<unsafe::Array*>(out)->length != n)
+        {
+            std::stringstream str;
+            str << "In jluna::parallel_transform: input has " << n << " elements but output has " << static_cast<unsafe::Array*>(out)->length;
+            throw std::out_of_range(str.str());
+        }
+
+        detail::parallel_for_ranges(n, grain_size, [&](uint64_t begin, uint64_t end, uint64_t)
+        {
+            for (uint64_t i = begin; i < end; ++i)
+                out_data[i] = f(in_data[i]);
+        });
+    }
+
+    template<is_isbits_compatible Value_t, uint64_t Rank, typename Function_t>
+    Value_t parallel_reduce(const Array<Value_t, Rank>& array, Value_t init, Function_t op, uint64_t grain_size)
+    {
+        const auto* data = detail::checked_array_data(array, "parallel_reduce");
+        auto n = static_cast<unsafe::Array*>(array)->length;
+
+        // one partial result per worker, padded so workers do not share a cache line
+        struct alignas(64) Partial
+        {
+            std::optional<Value_t> value;
+        };
+
+        std::vector<Partial> partials(ThreadPool::n_threads());
+
+        detail::parallel_for_ranges(n, grain_size, [&](uint64_t begin, uint64_t end, uint64_t worker_i)
+        {
+            Value_t result = data[begin];
+            for (uint64_t i = begin + 1; i < end; ++i)
+                result = op(result, data[i]);
+
+            auto& partial = partials.at(worker_i).value;
+            partial = partial.has_value() ? op(partial.value(), result) : result;
+        });
+
+        Value_t out = init;
+        for (auto& partial : partials)
+            if (partial.value.has_value())
+                out = op(out, partial.value.value());
+
+        return out;
+    }
+}
@@ -24,7 +24,9 @@ namespace jluna
         static jl_function_t* make_unnamed_proxy_id = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "make_unnamed_proxy_id"_sym);
         static jl_function_t* make_named_proxy_id = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "make_named_proxy_id"_sym);
 
-        gc_pause;
+        auto scope = detail::GCRootScope();
+        detail::gc_push(value);
+
         _value_key = new uint64_t(detail::create_reference(value));
         _value_ref = detail::get_reference(*_value_key);
 
@@ -34,16 +36,16 @@ namespace jluna
             _id_key = new uint64_t(detail::create_reference(jl_call2(make_named_proxy_id, (unsafe::Value*) id, jl_nothing)));
 
         _id_ref = detail::get_reference(*_id_key);
-
-        gc_unpause;
     }
 
     // with owner
     Proxy::ProxyValue::ProxyValue(unsafe::Value* value, std::shared_ptr<ProxyValue>& owner, unsafe::Value* id)
     {
-        gc_pause;
         static jl_function_t* make_named_proxy_id = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "make_named_proxy_id"_sym);
 
+        auto scope = detail::GCRootScope();
+        detail::gc_push(value, id);
+
         _owner = owner;
 
         _value_key = new uint64_t(detail::create_reference(value));
@@ -51,8 +53,6 @@ namespace jluna
 
         _id_key = new uint64_t(detail::create_reference(jl_call2(make_named_proxy_id, id, owner->id())));
         _id_ref = detail::get_reference(*_id_key);
-
-        gc_unpause;
     }
 
     Proxy::ProxyValue::~ProxyValue()
@@ -84,6 +84,16 @@ namespace jluna
         return nullptr; // unreachable
     }
 
+    uint64_t Proxy::ProxyValue::generation() const
+    {
+        return _generation;
+    }
+
+    void Proxy::ProxyValue::increment_generation()
+    {
+        _generation += 1;
+    }
+
     unsafe::Value* Proxy::ProxyValue::get_field(jl_sym_t* symbol) const
     {
         static jl_function_t* dot = unsafe::get_function("jluna"_sym, "dot"_sym);
@@ -188,16 +198,18 @@ namespace jluna
 
     Proxy & Proxy::operator=(unsafe::Value* new_value)
     {
-        gc_pause;
         static jl_function_t* assign = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "assign"_sym);
         static jl_function_t* set_reference = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "set_reference"_sym);
 
+        auto scope = detail::GCRootScope();
+        detail::gc_push(new_value);
+
         _content->_value_ref = jluna::safe_call(set_reference, jl_box_uint64(*_content->_value_key), new_value);
+        _content->increment_generation();
 
         if (_content->_is_mutating)
             jluna::safe_call(assign, new_value, _content->id());
 
-        gc_unpause;
         return *this;
     }
 
@@ -212,10 +224,10 @@ namespace jluna
         static jl_function_t* evaluate = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "evaluate"_sym);
         static jl_function_t* set_reference = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "set_reference"_sym);
 
-        gc_pause;
-        auto* new_value = jluna::safe_call(evaluate, _content->id());
+        auto scope = detail::GCRootScope();
+        auto* new_value = detail::gc_save(jluna::safe_call(evaluate, _content->id()));
         _content->_value_ref = jluna::safe_call(set_reference, jl_box_uint64(*_content->_value_key), new_value);
-        gc_unpause;
+        _content->increment_generation();
     }
 
     bool Proxy::isa(const Type& type)
@@ -8,6 +8,7 @@
 #include <include/type.hpp>
 #include <include/module.hpp>
 #include <mutex>
+#include <optional>
 
 namespace jluna
 {
@@ -72,10 +73,78 @@ namespace jluna::detail
     {
         jl_eval_string(R"([JULIA][LOG] Shutting down...)");
         jl_eval_string("jluna.memory_handler.force_free()");
-        jl_eval_string("jluna.gc_sentinel.shutdown()");
         jl_atexit_hook(0);
     }
 
+    unsafe::Value* safe_call_aux(unsafe::Value** function_and_args, uint64_t n)
+    {
+        static auto* capture_exception = unsafe::get_function("jluna"_sym, "capture_exception"_sym);
+
+        // c.f. jl_call, except the exception is captured while still being handled, so its backtrace is available
+        unsafe::Value* result = nullptr;
+        unsafe::Value* exception = nullptr;
+        std::optional<detail::GCRootScope> scope;
+        auto* task = jl_current_task;
+
+        JL_TRY
+        {
+            unsafe::Value** argv;
+            JL_GC_PUSHARGS(argv, n);
+            for (uint64_t i = 0; i < n; ++i)
+                argv[i] = function_and_args[i];
+
+            size_t last_age = task->world_age;
+            task->world_age = jl_get_world_counter();
+            result = jl_apply(argv, n);
+            task->world_age = last_age;
+            JL_GC_POP();
+            jl_exception_clear();
+        }
+        JL_CATCH
+        {
+            exception = jl_call1(capture_exception, jl_current_exception());
+            if (exception == nullptr)
+                exception = jl_current_exception();
+
+            // the exception stack stops rooting the exception once the catch block exits
+            scope.emplace();
+            detail::gc_push(exception);
+        }
+
+        if (exception != nullptr)
+            throw JuliaException(exception);
+
+        return result;
+    }
+
+    void safe_invoke_aux(void (*trampoline)(void*), void* data)
+    {
+        static auto* capture_exception = unsafe::get_function("jluna"_sym, "capture_exception"_sym);
+
+        // trampoline calls into compiled Julia code, it may not own any objects with non-trivial dtors, as they are skipped if an exception occurs
+        unsafe::Value* exception = nullptr;
+        std::optional<detail::GCRootScope> scope;
+
+        JL_TRY
+        {
+            trampoline(data);
+            jl_exception_clear();
+        }
+        JL_CATCH
+        {
+            exception = jl_call1(capture_exception, jl_current_exception());
+            if (exception == nullptr)
+                exception = jl_current_exception();
+
+            // the exception stack stops rooting the exception once the catch block exits
+            scope.emplace();
+            detail::gc_push(exception);
+        }
+
+        if (exception != nullptr)
+            throw JuliaException(exception);
+    }
+
     uint64_t create_reference(unsafe::Value* in)
     {
         throw_if_uninitialized();
@@ -91,8 +160,30 @@ namespace jluna::detail
 
     unsafe::Value* get_reference(uint64_t key)
     {
-        static unsafe::Function* get_reference = unsafe::get_function((unsafe::Module*) jl_eval_string("jluna.memory_handler"), "get_reference"_sym);
-        return jluna::safe_call(get_reference, jl_box_uint64(static_cast<uint64_t>(key)));
+        // slabs are never moved julia-side, so they can be indexed without calling into julia
+        static auto* shards = (unsafe::Array*) jl_eval_string("return jluna.memory_handler._refs[]._shard_slabs");
+        static auto* shard_generations = (unsafe::Array*) jl_eval_string("return jluna.memory_handler._refs[]._shard_generations");
+
+        if (key == 0)
+            return jl_nothing;
+
+        uint64_t shard = (key >> _reference_shard_shift) & _reference_shard_mask;
+        uint64_t local_key = (key & ((uint64_t(1) << _reference_shard_shift) - 1)) - 1;
+        uint64_t slab_index = local_key / _reference_slab_size;
+        uint64_t slot_index = local_key % _reference_slab_size;
+
+        // the slot was freed and possibly handed to a different key since this key was created
+        auto* generations = reinterpret_cast<unsafe::Array**>(reinterpret_cast<unsafe::Array**>(shard_generations->data)[shard]->data)[slab_index];
+        if (reinterpret_cast<uint8_t*>(generations->data)[slot_index] != uint8_t(key >> _reference_generation_shift))
+        {
+            std::stringstream str;
+            str << "In jluna::detail::get_reference: reference " << key << " was already freed" << std::endl;
+            throw std::invalid_argument(str.str());
+        }
+
+        auto* slabs = reinterpret_cast<unsafe::Array**>(shards->data)[shard];
+        auto* slab = reinterpret_cast<unsafe::Array**>(slabs->data)[slab_index];
+        return reinterpret_cast<unsafe::Value**>(slab->data)[slot_index];
     }
 
     void free_reference(uint64_t key)
@@ -19,6 +19,21 @@ namespace jluna::detail
 
     constexpr char _id_marker = '#';
 
+    // has to match jluna.memory_handler._slab_size
+    constexpr uint64_t _reference_slab_size = 1024;
+
+    // has to match jluna.memory_handler._shard_shift
+    constexpr uint64_t _reference_shard_shift = 48;
+
+    // has to match jluna.memory_handler._shard_mask
+    constexpr uint64_t _reference_shard_mask = 0xFF;
+
+    // has to match jluna.memory_handler._generation_shift
+    constexpr uint64_t _reference_generation_shift = 56;
+
+    unsafe::Value* safe_call_aux(unsafe::Value** function_and_args, uint64_t n);
+    void safe_invoke_aux(void (*trampoline)(void*), void* data);
+
     uint64_t create_reference(unsafe::Value* in);
     unsafe::Value* get_reference(uint64_t key);
     void free_reference(uint64_t key);
@@ -40,23 +55,9 @@ namespace jluna
     {
         throw_if_uninitialized();
 
-        static auto* jl_safe_call = unsafe::get_function("jluna"_sym, "safe_call"_sym);
-
-        static std::array<unsafe::Value*, sizeof...(Args_t) + 1> args;
-        static auto set = [&](uint64_t i, unsafe::Value* x) {args[i] = x;};
-
-        args[0] = (unsafe::Value*) function;
-
-        uint64_t i = 1;
-        (set(i++, (unsafe::Value*) in), ...);
-
-        auto* tuple_res = jl_call(jl_safe_call, args.data(), args.size());
-
-        if (jl_unbox_bool(jl_get_nth_field(tuple_res, 1)))
-            throw JuliaException(jl_get_nth_field(tuple_res, 2), jl_string_ptr(jl_get_nth_field(tuple_res, 3)));
-
-        auto* res = jl_get_nth_field(tuple_res, 0);
-        return res;
+        // stack storage, so concurrent calls do not share a buffer. Arguments are rooted by detail::safe_call_aux
+        std::array<unsafe::Value*, sizeof...(Args_t) + 1> args = {(unsafe::Value*) function, (unsafe::Value*) in...};
+        return detail::safe_call_aux(args.data(), args.size());
     }
 
     #ifdef _MSC_VER
@@ -117,6 +118,9 @@ namespace jluna
 
         forward_last_exception();
 
+        // values on C++-side root stacks, c.f. detail::gc_push
+        jl_gc_set_cb_root_scanner(&detail::GCRootStack::mark_all, 1);
+
         auto* res = jl_eval_string(detail::julia_source.c_str());
         assert(res != nullptr && jl_unbox_bool(res));
 
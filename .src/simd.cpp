@@ -0,0 +1,213 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#include <include/simd.hpp>
+
+#include <cmath>
+#include <concepts>
+#include <limits>
+
+// each kernel is compiled once per instruction set, the best version for the current CPU is selected when the library is loaded
+#if defined(__x86_64__) and defined(__linux__) and defined(__GNUC__) and not defined(__clang__) and __GNUC__ >= 12
+    #define JLUNA_SIMD_TARGET_CLONES __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "arch=x86-64-v2", "default")))
+#elif defined(__x86_64__) and defined(__linux__) and (defined(__GNUC__) or defined(__clang__))
+    #define JLUNA_SIMD_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "sse4.2", "default")))
+#else
+    #define JLUNA_SIMD_TARGET_CLONES
+#endif
+
+#if defined(__GNUC__) or defined(__clang__)
+    #define JLUNA_SIMD_INLINE [[gnu::always_inline]] inline
+#else
+    #define JLUNA_SIMD_INLINE inline
+#endif
+
+namespace jluna::detail
+{
+    namespace
+    {
+        // number of independent accumulators, one 512-bit register worth. Splitting the reduction into lanes allows
+        // it to be vectorized without the compiler having to reassociate floating point operations
+        template<typename T>
+        constexpr uint64_t n_lanes = 64 / sizeof(T);
+
+        // integer arithmetic is done unsigned and at least as wide as int, so overflow wraps around like it does Julia-side instead of being undefined
+        template<typename T>
+        struct wrapping
+        {
+            using type = T;
+        };
+
+        template<std::integral T>
+        struct wrapping<T>
+        {
+            using type = std::conditional_t<(sizeof(T) < sizeof(unsigned int)), unsigned int, std::make_unsigned_t<T>>;
+        };
+
+        template<typename T>
+        using wrapping_t = typename wrapping<T>::type;
+
+        template<typename T>
+        JLUNA_SIMD_INLINE simd::sum_t<T> sum_aux(const T* a, uint64_t n)
+        {
+            using Sum_t = wrapping_t<simd::sum_t<T>>;
+            Sum_t lanes[n_lanes<Sum_t>] = {};
+
+            uint64_t i = 0;
+            for (; i + n_lanes<Sum_t> <= n; i += n_lanes<Sum_t>)
+                for (uint64_t j = 0; j < n_lanes<Sum_t>; ++j)
+                    lanes[j] += static_cast<Sum_t>(a[i + j]);
+
+            Sum_t out = 0;
+            for (uint64_t j = 0; j < n_lanes<Sum_t>; ++j)
+                out += lanes[j];
+
+            for (; i < n; ++i)
+                out += static_cast<Sum_t>(a[i]);
+
+            return static_cast<simd::sum_t<T>>(out);
+        }
+
+        template<typename T>
+        JLUNA_SIMD_INLINE T dot_aux(const T* a, const T* b, uint64_t n)
+        {
+            using Dot_t = wrapping_t<T>;
+            Dot_t lanes[n_lanes<T>] = {};
+
+            uint64_t i = 0;
+            for (; i + n_lanes<T> <= n; i += n_lanes<T>)
+                for (uint64_t j = 0; j < n_lanes<T>; ++j)
+                    lanes[j] += Dot_t(a[i + j]) * Dot_t(b[i + j]);
+
+            Dot_t out = 0;
+            for (uint64_t j = 0; j < n_lanes<T>; ++j)
+                out += lanes[j];
+
+            for (; i < n; ++i)
+                out += Dot_t(a[i]) * Dot_t(b[i]);
+
+            return static_cast<T>(out);
+        }
+
+        // n > 0
+        template<bool IsMinimum, typename T>
+        JLUNA_SIMD_INLINE T extremum_aux(const T* a, uint64_t n)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                // comparisons below ignore NaN, while Base.minimum and Base.maximum propagate it
+                bool has_nan = false;
+                for (uint64_t i = 0; i < n; ++i)
+                    has_nan |= a[i] != a[i];
+
+                if (has_nan)
+                    return std::numeric_limits<T>::quiet_NaN();
+            }
+
+            T lanes[n_lanes<T>];
+            for (uint64_t j = 0; j < n_lanes<T>; ++j)
+                lanes[j] = a[0];
+
+            uint64_t i = 0;
+            for (; i + n_lanes<T> <= n; i += n_lanes<T>)
+                for (uint64_t j = 0; j < n_lanes<T>; ++j)
+                    lanes[j] = IsMinimum ? (a[i + j] < lanes[j] ? a[i + j] : lanes[j]) : (a[i + j] > lanes[j] ? a[i + j] : lanes[j]);
+
+            T out = lanes[0];
+            for (uint64_t j = 1; j < n_lanes<T>; ++j)
+                out = IsMinimum ? (lanes[j] < out ? lanes[j] : out) : (lanes[j] > out ? lanes[j] : out);
+
+            for (; i < n; ++i)
+                out = IsMinimum ? (a[i] < out ? a[i] : out) : (a[i] > out ? a[i] : out);
+
+            return out;
+        }
+
+        template<typename T>
+        JLUNA_SIMD_INLINE T fma_aux(T a, T b, T c)
+        {
+            // Base.fma on integers is equivalent to a * b + c
+            if constexpr (std::is_floating_point_v<T>)
+                return std::fma(a, b, c);
+            else
+                return static_cast<T>(wrapping_t<T>(a) * wrapping_t<T>(b) + wrapping_t<T>(c));
+        }
+    }
+
+    #define JLUNA_DEFINE_SIMD_KERNELS(T) \
+        JLUNA_SIMD_TARGET_CLONES void simd_add(const T* a, const T* b, T* out, uint64_t n) \
+        { \
+            for (uint64_t i = 0; i < n; ++i) \
+                out[i] = static_cast<T>(wrapping_t<T>(a[i]) + wrapping_t<T>(b[i])); \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES void simd_subtract(const T* a, const T* b, T* out, uint64_t n) \
+        { \
+            for (uint64_t i = 0; i < n; ++i) \
+                out[i] = static_cast<T>(wrapping_t<T>(a[i]) - wrapping_t<T>(b[i])); \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES void simd_multiply(const T* a, const T* b, T* out, uint64_t n) \
+        { \
+            for (uint64_t i = 0; i < n; ++i) \
+                out[i] = static_cast<T>(wrapping_t<T>(a[i]) * wrapping_t<T>(b[i])); \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES void simd_fma(const T* a, const T* b, const T* c, T* out, uint64_t n) \
+        { \
+            for (uint64_t i = 0; i < n; ++i) \
+                out[i] = fma_aux<T>(a[i], b[i], c[i]); \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES simd::sum_t<T> simd_sum(const T* a, uint64_t n) \
+        { \
+            return sum_aux<T>(a, n); \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES T simd_minimum(const T* a, uint64_t n) \
+        { \
+            return extremum_aux<true, T>(a, n); \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES T simd_maximum(const T* a, uint64_t n) \
+        { \
+            return extremum_aux<false, T>(a, n); \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES T simd_dot(const T* a, const T* b, uint64_t n) \
+        { \
+            return dot_aux<T>(a, b, n); \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES void simd_equal(const T* a, const T* b, bool* out, uint64_t n) \
+        { \
+            for (uint64_t i = 0; i < n; ++i) \
+                out[i] = a[i] == b[i]; \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES void simd_less(const T* a, const T* b, bool* out, uint64_t n) \
+        { \
+            for (uint64_t i = 0; i < n; ++i) \
+                out[i] = a[i] < b[i]; \
+        } \
+        \
+        JLUNA_SIMD_TARGET_CLONES void simd_greater(const T* a, const T* b, bool* out, uint64_t n) \
+        { \
+            for (uint64_t i = 0; i < n; ++i) \
+                out[i] = a[i] > b[i]; \
+        }
+
+    JLUNA_DEFINE_SIMD_KERNELS(Int8)
+    JLUNA_DEFINE_SIMD_KERNELS(Int16)
+    JLUNA_DEFINE_SIMD_KERNELS(Int32)
+    JLUNA_DEFINE_SIMD_KERNELS(Int64)
+    JLUNA_DEFINE_SIMD_KERNELS(UInt8)
+    JLUNA_DEFINE_SIMD_KERNELS(UInt16)
+    JLUNA_DEFINE_SIMD_KERNELS(UInt32)
+    JLUNA_DEFINE_SIMD_KERNELS(UInt64)
+    JLUNA_DEFINE_SIMD_KERNELS(Float32)
+    JLUNA_DEFINE_SIMD_KERNELS(Float64)
+
+    #undef JLUNA_DEFINE_SIMD_KERNELS
+}
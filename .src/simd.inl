@@ -0,0 +1,492 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <initializer_list>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace jluna::detail
+{
+    template<typename... Arrays>
+    uint64_t simd_n_elements(const char* function_name, const Arrays&... arrays)
+    {
+        const uint64_t n = (static_cast<unsafe::Array*>(arrays)->length, ...);
+        if (((static_cast<unsafe::Array*>(arrays)->length != n) or ...))
+        {
+            std::stringstream str;
+            str << "In jluna::" << function_name << ": number of elements does not match, sizes are";
+            ((str << " " << static_cast<unsafe::Array*>(arrays)->length), ...);
+            throw std::out_of_range(str.str());
+        }
+
+        return n;
+    }
+}
+
+namespace jluna::simd
+{
+    template<is_simd_compatible T, uint64_t Rank>
+    void add(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<T, Rank>& out)
+    {
+        const auto n = detail::simd_n_elements("simd::add", a, b, out);
+        detail::simd_add(
+            detail::checked_array_data(a, "simd::add"),
+            detail::checked_array_data(b, "simd::add"),
+            detail::checked_array_data(out, "simd::add"),
+            n
+        );
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    void subtract(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<T, Rank>& out)
+    {
+        const auto n = detail::simd_n_elements("simd::subtract", a, b, out);
+        detail::simd_subtract(
+            detail::checked_array_data(a, "simd::subtract"),
+            detail::checked_array_data(b, "simd::subtract"),
+            detail::checked_array_data(out, "simd::subtract"),
+            n
+        );
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    void multiply(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<T, Rank>& out)
+    {
+        const auto n = detail::simd_n_elements("simd::multiply", a, b, out);
+        detail::simd_multiply(
+            detail::checked_array_data(a, "simd::multiply"),
+            detail::checked_array_data(b, "simd::multiply"),
+            detail::checked_array_data(out, "simd::multiply"),
+            n
+        );
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    void fma(const Array<T, Rank>& a, const Array<T, Rank>& b, const Array<T, Rank>& c, Array<T, Rank>& out)
+    {
+        const auto n = detail::simd_n_elements("simd::fma", a, b, c, out);
+        detail::simd_fma(
+            detail::checked_array_data(a, "simd::fma"),
+            detail::checked_array_data(b, "simd::fma"),
+            detail::checked_array_data(c, "simd::fma"),
+            detail::checked_array_data(out, "simd::fma"),
+            n
+        );
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    sum_t<T> sum(const Array<T, Rank>& a)
+    {
+        const auto n = detail::simd_n_elements("simd::sum", a);
+        return detail::simd_sum(detail::checked_array_data(a, "simd::sum"), n);
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    T minimum(const Array<T, Rank>& a)
+    {
+        const auto n = detail::simd_n_elements("simd::minimum", a);
+        if (n == 0)
+            throw std::invalid_argument("In jluna::simd::minimum: reducing over an empty collection is not allowed");
+
+        return detail::simd_minimum(detail::checked_array_data(a, "simd::minimum"), n);
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    T maximum(const Array<T, Rank>& a)
+    {
+        const auto n = detail::simd_n_elements("simd::maximum", a);
+        if (n == 0)
+            throw std::invalid_argument("In jluna::simd::maximum: reducing over an empty collection is not allowed");
+
+        return detail::simd_maximum(detail::checked_array_data(a, "simd::maximum"), n);
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    T dot(const Array<T, Rank>& a, const Array<T, Rank>& b)
+    {
+        const auto n = detail::simd_n_elements("simd::dot", a, b);
+        return detail::simd_dot(
+            detail::checked_array_data(a, "simd::dot"),
+            detail::checked_array_data(b, "simd::dot"),
+            n
+        );
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    void equal(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<bool, Rank>& out)
+    {
+        const auto n = detail::simd_n_elements("simd::equal", a, b, out);
+        detail::simd_equal(
+            detail::checked_array_data(a, "simd::equal"),
+            detail::checked_array_data(b, "simd::equal"),
+            detail::checked_array_data(out, "simd::equal"),
+            n
+        );
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    void less(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<bool, Rank>& out)
+    {
+        const auto n = detail::simd_n_elements("simd::less", a, b, out);
+        detail::simd_less(
+            detail::checked_array_data(a, "simd::less"),
+            detail::checked_array_data(b, "simd::less"),
+            detail::checked_array_data(out, "simd::less"),
+            n
+        );
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    void greater(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<bool, Rank>& out)
+    {
+        const auto n = detail::simd_n_elements("simd::greater", a, b, out);
+        detail::simd_greater(
+            detail::checked_array_data(a, "simd::greater"),
+            detail::checked_array_data(b, "simd::greater"),
+            detail::checked_array_data(out, "simd::greater"),
+            n
+        );
+    }
+}
+
+namespace jluna::detail
+{
+    inline void throw_if_size_mismatch(const char* function_name, std::initializer_list<uint64_t> sizes)
+    {
+        const uint64_t n = *sizes.begin();
+        for (auto size : sizes)
+        {
+            if (size == n)
+                continue;
+
+            std::stringstream str;
+            str << "In jluna::" << function_name << ": number of elements does not match, sizes are";
+            for (auto s : sizes)
+                str << " " << s;
+
+            throw std::out_of_range(str.str());
+        }
+    }
+
+    // accumulates results of multiple blocks, integers are accumulated unsigned so overflow wraps around like it does Julia-side
+    template<typename T>
+    struct simd_accumulator
+    {
+        using type = T;
+    };
+
+    template<std::integral T>
+    struct simd_accumulator<T>
+    {
+        using type = std::make_unsigned_t<T>;
+    };
+
+    template<typename T>
+    using simd_accumulator_t = typename simd_accumulator<T>::type;
+
+    // invokes f(offset, n) for consecutive blocks of at most simd::block_size elements
+    template<typename Function_t>
+    void for_each_block(uint64_t size, Function_t f)
+    {
+        for (uint64_t offset = 0; offset < size; offset += simd::block_size)
+            f(offset, std::min<uint64_t>(simd::block_size, size - offset));
+    }
+}
+
+namespace jluna::simd
+{
+    template<is_simd_compatible T>
+    template<uint64_t Rank>
+    Operand<T>::Operand(const Array<T, Rank>& array)
+        : _data(detail::checked_array_data(array, "simd::expr")), _size(static_cast<unsafe::Array*>(array)->length)
+    {}
+
+    template<is_simd_compatible T>
+    uint64_t Operand<T>::size() const
+    {
+        return _size;
+    }
+
+    template<is_simd_compatible T>
+    const T* Operand<T>::evaluate(uint64_t offset, uint64_t, T*) const
+    {
+        return _data + offset;
+    }
+
+    template<is_expression Lhs, is_expression Rhs, detail::SimdOperation Operation>
+    ArithmeticExpression<Lhs, Rhs, Operation>::ArithmeticExpression(const Lhs& lhs, const Rhs& rhs)
+        : _lhs(lhs), _rhs(rhs)
+    {
+        detail::throw_if_size_mismatch("simd::ArithmeticExpression", {_lhs.size(), _rhs.size()});
+    }
+
+    template<is_expression Lhs, is_expression Rhs, detail::SimdOperation Operation>
+    uint64_t ArithmeticExpression<Lhs, Rhs, Operation>::size() const
+    {
+        return _lhs.size();
+    }
+
+    template<is_expression Lhs, is_expression Rhs, detail::SimdOperation Operation>
+    auto ArithmeticExpression<Lhs, Rhs, Operation>::evaluate(uint64_t offset, uint64_t n, value_type* buffer) const -> const value_type*
+    {
+        // operands that are arrays do not use their buffer
+        alignas(64) value_type lhs_buffer[block_size];
+        alignas(64) value_type rhs_buffer[block_size];
+
+        const auto* lhs = _lhs.evaluate(offset, n, lhs_buffer);
+        const auto* rhs = _rhs.evaluate(offset, n, rhs_buffer);
+
+        if constexpr (Operation == detail::SimdOperation::ADD)
+            detail::simd_add(lhs, rhs, buffer, n);
+        else if constexpr (Operation == detail::SimdOperation::SUBTRACT)
+            detail::simd_subtract(lhs, rhs, buffer, n);
+        else if constexpr (Operation == detail::SimdOperation::MULTIPLY)
+            detail::simd_multiply(lhs, rhs, buffer, n);
+        else
+            static_assert(Operation == detail::SimdOperation::ADD, "In jluna::simd::ArithmeticExpression: unsupported operation");
+
+        return buffer;
+    }
+
+    template<is_expression A, is_expression B, is_expression C>
+    FmaExpression<A, B, C>::FmaExpression(const A& a, const B& b, const C& c)
+        : _a(a), _b(b), _c(c)
+    {
+        detail::throw_if_size_mismatch("simd::FmaExpression", {_a.size(), _b.size(), _c.size()});
+    }
+
+    template<is_expression A, is_expression B, is_expression C>
+    uint64_t FmaExpression<A, B, C>::size() const
+    {
+        return _a.size();
+    }
+
+    template<is_expression A, is_expression B, is_expression C>
+    auto FmaExpression<A, B, C>::evaluate(uint64_t offset, uint64_t n, value_type* buffer) const -> const value_type*
+    {
+        alignas(64) value_type a_buffer[block_size];
+        alignas(64) value_type b_buffer[block_size];
+        alignas(64) value_type c_buffer[block_size];
+
+        detail::simd_fma(
+            _a.evaluate(offset, n, a_buffer),
+            _b.evaluate(offset, n, b_buffer),
+            _c.evaluate(offset, n, c_buffer),
+            buffer,
+            n
+        );
+
+        return buffer;
+    }
+
+    template<is_expression Lhs, is_expression Rhs, detail::SimdOperation Operation>
+    ComparisonExpression<Lhs, Rhs, Operation>::ComparisonExpression(const Lhs& lhs, const Rhs& rhs)
+        : _lhs(lhs), _rhs(rhs)
+    {
+        detail::throw_if_size_mismatch("simd::ComparisonExpression", {_lhs.size(), _rhs.size()});
+    }
+
+    template<is_expression Lhs, is_expression Rhs, detail::SimdOperation Operation>
+    uint64_t ComparisonExpression<Lhs, Rhs, Operation>::size() const
+    {
+        return _lhs.size();
+    }
+
+    template<is_expression Lhs, is_expression Rhs, detail::SimdOperation Operation>
+    const bool* ComparisonExpression<Lhs, Rhs, Operation>::evaluate(uint64_t offset, uint64_t n, bool* buffer) const
+    {
+        using Operand_t = typename Lhs::value_type;
+        alignas(64) Operand_t lhs_buffer[block_size];
+        alignas(64) Operand_t rhs_buffer[block_size];
+
+        const auto* lhs = _lhs.evaluate(offset, n, lhs_buffer);
+        const auto* rhs = _rhs.evaluate(offset, n, rhs_buffer);
+
+        if constexpr (Operation == detail::SimdOperation::EQUAL)
+            detail::simd_equal(lhs, rhs, buffer, n);
+        else if constexpr (Operation == detail::SimdOperation::LESS)
+            detail::simd_less(lhs, rhs, buffer, n);
+        else if constexpr (Operation == detail::SimdOperation::GREATER)
+            detail::simd_greater(lhs, rhs, buffer, n);
+        else
+            static_assert(Operation == detail::SimdOperation::EQUAL, "In jluna::simd::ComparisonExpression: unsupported operation");
+
+        return buffer;
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    Operand<T> expr(const Array<T, Rank>& array)
+    {
+        return Operand<T>(array);
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ArithmeticExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::ADD> add(const Lhs& lhs, const Rhs& rhs)
+    {
+        return {detail::as_expression(lhs), detail::as_expression(rhs)};
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ArithmeticExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::SUBTRACT> subtract(const Lhs& lhs, const Rhs& rhs)
+    {
+        return {detail::as_expression(lhs), detail::as_expression(rhs)};
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ArithmeticExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::MULTIPLY> multiply(const Lhs& lhs, const Rhs& rhs)
+    {
+        return {detail::as_expression(lhs), detail::as_expression(rhs)};
+    }
+
+    template<typename A, typename B, typename C> requires detail::is_simd_operands<false, A, B, C>
+    FmaExpression<detail::expression_t<A>, detail::expression_t<B>, detail::expression_t<C>> fma(const A& a, const B& b, const C& c)
+    {
+        return {detail::as_expression(a), detail::as_expression(b), detail::as_expression(c)};
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ComparisonExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::EQUAL> equal(const Lhs& lhs, const Rhs& rhs)
+    {
+        return {detail::as_expression(lhs), detail::as_expression(rhs)};
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ComparisonExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::LESS> less(const Lhs& lhs, const Rhs& rhs)
+    {
+        return {detail::as_expression(lhs), detail::as_expression(rhs)};
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ComparisonExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::GREATER> greater(const Lhs& lhs, const Rhs& rhs)
+    {
+        return {detail::as_expression(lhs), detail::as_expression(rhs)};
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<true, Lhs, Rhs>
+    auto operator+(const Lhs& lhs, const Rhs& rhs)
+    {
+        return simd::add(lhs, rhs);
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<true, Lhs, Rhs>
+    auto operator-(const Lhs& lhs, const Rhs& rhs)
+    {
+        return simd::subtract(lhs, rhs);
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<true, Lhs, Rhs>
+    auto operator*(const Lhs& lhs, const Rhs& rhs)
+    {
+        return simd::multiply(lhs, rhs);
+    }
+
+    template<is_expression Expression_t, uint64_t Rank>
+    void assign(Array<typename Expression_t::value_type, Rank>& out, const Expression_t& expression)
+    {
+        using Value_t = typename Expression_t::value_type;
+
+        auto* data = detail::checked_array_data(out, "simd::assign");
+        detail::throw_if_size_mismatch("simd::assign", {static_cast<unsafe::Array*>(out)->length, expression.size()});
+
+        // each block is read completely before it is written, so out may be one of the operands
+        detail::for_each_block(expression.size(), [&](uint64_t offset, uint64_t n) {
+            const auto* result = expression.evaluate(offset, n, data + offset);
+            if (result != data + offset)
+                std::memmove(data + offset, result, n * sizeof(Value_t));
+        });
+    }
+
+    template<is_expression Expression_t> requires is_simd_compatible<typename Expression_t::value_type>
+    sum_t<typename Expression_t::value_type> sum(const Expression_t& expression)
+    {
+        using Value_t = typename Expression_t::value_type;
+        using Sum_t = sum_t<Value_t>;
+
+        using Accumulator_t = detail::simd_accumulator_t<Sum_t>;
+        Accumulator_t out = 0;
+
+        detail::for_each_block(expression.size(), [&](uint64_t offset, uint64_t n) {
+            alignas(64) Value_t buffer[block_size];
+            out += static_cast<Accumulator_t>(detail::simd_sum(expression.evaluate(offset, n, buffer), n));
+        });
+
+        return static_cast<Sum_t>(out);
+    }
+
+    template<is_expression Expression_t> requires is_simd_compatible<typename Expression_t::value_type>
+    typename Expression_t::value_type minimum(const Expression_t& expression)
+    {
+        using Value_t = typename Expression_t::value_type;
+
+        if (expression.size() == 0)
+            throw std::invalid_argument("In jluna::simd::minimum: reducing over an empty collection is not allowed");
+
+        std::optional<Value_t> out;
+        detail::for_each_block(expression.size(), [&](uint64_t offset, uint64_t n) {
+            alignas(64) Value_t buffer[block_size];
+            auto block = detail::simd_minimum(expression.evaluate(offset, n, buffer), n);
+
+            // NaN of any block propagates
+            if (out.has_value() and out.value() != out.value())
+                return;
+
+            if (not out.has_value() or block < out.value() or block != block)
+                out = block;
+        });
+
+        return out.value();
+    }
+
+    template<is_expression Expression_t> requires is_simd_compatible<typename Expression_t::value_type>
+    typename Expression_t::value_type maximum(const Expression_t& expression)
+    {
+        using Value_t = typename Expression_t::value_type;
+
+        if (expression.size() == 0)
+            throw std::invalid_argument("In jluna::simd::maximum: reducing over an empty collection is not allowed");
+
+        std::optional<Value_t> out;
+        detail::for_each_block(expression.size(), [&](uint64_t offset, uint64_t n) {
+            alignas(64) Value_t buffer[block_size];
+            auto block = detail::simd_maximum(expression.evaluate(offset, n, buffer), n);
+
+            // NaN of any block propagates
+            if (out.has_value() and out.value() != out.value())
+                return;
+
+            if (not out.has_value() or block > out.value() or block != block)
+                out = block;
+        });
+
+        return out.value();
+    }
+
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<true, Lhs, Rhs>
+    typename detail::expression_t<Lhs>::value_type dot(const Lhs& lhs, const Rhs& rhs)
+    {
+        using Value_t = typename detail::expression_t<Lhs>::value_type;
+        using Accumulator_t = detail::simd_accumulator_t<Value_t>;
+
+        const auto& lhs_expression = detail::as_expression(lhs);
+        const auto& rhs_expression = detail::as_expression(rhs);
+        detail::throw_if_size_mismatch("simd::dot", {lhs_expression.size(), rhs_expression.size()});
+
+        Accumulator_t out = 0;
+        detail::for_each_block(lhs_expression.size(), [&](uint64_t offset, uint64_t n) {
+            alignas(64) Value_t lhs_buffer[block_size];
+            alignas(64) Value_t rhs_buffer[block_size];
+            out += static_cast<Accumulator_t>(detail::simd_dot(
+                lhs_expression.evaluate(offset, n, lhs_buffer),
+                rhs_expression.evaluate(offset, n, rhs_buffer),
+                n
+            ));
+        });
+
+        return static_cast<Value_t>(out);
+    }
+}
@@ -0,0 +1,228 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#pragma once
+
+#include <include/typedefs.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace jluna::detail
+{
+    struct TaskSuper;
+
+    /// @brief type-erased storage for a single object, constructed in-place if it fits, on the heap otherwise
+    template<uint64_t Capacity>
+    class SmallStorage
+    {
+        public:
+            SmallStorage() = default;
+
+            ~SmallStorage()
+            {
+                reset();
+            }
+
+            SmallStorage(const SmallStorage&) = delete;
+            SmallStorage& operator=(const SmallStorage&) = delete;
+
+            /// @brief construct object, destroys the currently held object, if any
+            /// @param args: forwarded to ctor of T
+            /// @returns pointer to new object
+            template<typename T, typename... Args_t>
+            T* emplace(Args_t&&... args)
+            {
+                reset();
+
+                if constexpr (sizeof(T) <= Capacity and alignof(T) <= alignof(std::max_align_t))
+                {
+                    _ptr = new (_buffer) T(std::forward<Args_t>(args)...);
+                    _destroy = [](void* ptr) { static_cast<T*>(ptr)->~T(); };
+                }
+                else
+                {
+                    _ptr = new T(std::forward<Args_t>(args)...);
+                    _destroy = [](void* ptr) { delete static_cast<T*>(ptr); };
+                }
+
+                return static_cast<T*>(_ptr);
+            }
+
+            /// @brief destroy held object, if any
+            void reset()
+            {
+                if (_ptr == nullptr)
+                    return;
+
+                _destroy(_ptr);
+                _ptr = nullptr;
+            }
+
+            /// @brief access object
+            /// @returns pointer to object, or nullptr if empty
+            void* get() const
+            {
+                return _ptr;
+            }
+
+        private:
+            alignas(std::max_align_t) std::byte _buffer[Capacity];
+            void* _ptr = nullptr;
+            void (*_destroy)(void*) = nullptr;
+    };
+
+    /// @brief callable with signature () -> unsafe::Value*, lambdas with small captures are stored without allocation
+    class TaskFunction
+    {
+        public:
+            /// @brief assign lambda
+            /// @param lambda
+            template<typename Lambda_t>
+            void emplace(Lambda_t&& lambda)
+            {
+                using Decayed_t = std::decay_t<Lambda_t>;
+                _storage.emplace<Decayed_t>(std::forward<Lambda_t>(lambda));
+                _invoke = [](void* ptr) -> unsafe::Value* {
+                    return (*static_cast<Decayed_t*>(ptr))();
+                };
+            }
+
+            /// @brief invoke lambda
+            /// @returns result
+            unsafe::Value* operator()()
+            {
+                return _invoke(_storage.get());
+            }
+
+            /// @brief register function that is invoked once, after the next invocation returned
+            /// @param f: function, invoked with arg
+            /// @param arg
+            void set_on_finish(void (*f)(uint64_t), uint64_t arg)
+            {
+                _on_finish = f;
+                _on_finish_arg = arg;
+            }
+
+            /// @brief invoke and clear function registered via set_on_finish, if any. May destroy this
+            void finish()
+            {
+                auto* f = _on_finish;
+                _on_finish = nullptr;
+
+                if (f != nullptr)
+                    f(_on_finish_arg);
+            }
+
+            /// @brief destroy lambda
+            void reset()
+            {
+                _storage.reset();
+                _invoke = nullptr;
+                _on_finish = nullptr;
+            }
+
+        private:
+            SmallStorage<128> _storage;
+            unsafe::Value* (*_invoke)(void*) = nullptr;
+            void (*_on_finish)(uint64_t) = nullptr;
+            uint64_t _on_finish_arg = 0;
+    };
+
+    /// @brief storage for one task, slots are never deallocated so pointers into them stay valid
+    struct TaskSlot
+    {
+        TaskFunction function;
+        SmallStorage<256> value;
+        TaskSuper* task = nullptr;
+
+        // number of owners, the slot is destroyed once the last of them releases it
+        std::atomic<uint64_t> n_owners = 0;
+
+        // index + 1 of next slot in free list, 0 if last
+        std::atomic<uint64_t> next_free = 0;
+    };
+
+    /// @brief lock-free pool of task slots, ids of released slots are reused
+    class TaskPool
+    {
+        public:
+            /// @brief number of slots allocated at once
+            static constexpr uint64_t chunk_size = 256;
+
+            /// @brief maximum number of chunks, limits the number of tasks alive at the same time
+            static constexpr uint64_t max_n_chunks = 4096;
+
+            /// @brief get id of unused slot
+            /// @returns id
+            uint64_t acquire()
+            {
+                uint64_t head = _free_head.load(std::memory_order_acquire);
+                while ((head & _index_mask) != 0)
+                {
+                    uint64_t index = (head & _index_mask) - 1;
+                    uint64_t next = at(index).next_free.load(std::memory_order_relaxed);
+
+                    // tag is increased on every exchange, so a head that was popped and pushed again in between is detected
+                    uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+                    if (_free_head.compare_exchange_weak(head, new_head, std::memory_order_acq_rel, std::memory_order_acquire))
+                        return index;
+                }
+
+                uint64_t index = _n_slots.fetch_add(1, std::memory_order_relaxed);
+                uint64_t chunk_i = index / chunk_size;
+
+                if (chunk_i >= max_n_chunks)
+                    throw std::out_of_range("In jluna::ThreadPool::create: too many tasks alive at the same time");
+
+                if (_chunks[chunk_i].load(std::memory_order_acquire) == nullptr)
+                {
+                    auto* fresh = new TaskSlot[chunk_size];
+                    TaskSlot* expected = nullptr;
+                    if (not _chunks[chunk_i].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+                        delete[] fresh;
+                }
+
+                return index;
+            }
+
+            /// @brief access slot
+            /// @param id: result of acquire
+            /// @returns reference to slot
+            TaskSlot& at(uint64_t id)
+            {
+                return _chunks[id / chunk_size].load(std::memory_order_acquire)[id % chunk_size];
+            }
+
+            /// @brief mark slot as unused, its content has to be destroyed before
+            /// @param id: result of acquire
+            void release(uint64_t id)
+            {
+                auto& slot = at(id);
+                uint64_t head = _free_head.load(std::memory_order_relaxed);
+                uint64_t new_head;
+
+                do
+                {
+                    slot.next_free.store(head & _index_mask, std::memory_order_relaxed);
+                    new_head = (((head >> 32) + 1) << 32) | (id + 1);
+                }
+                while (not _free_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+        private:
+            static constexpr uint64_t _index_mask = 0xFFFFFFFF;
+
+            // chunks are intentionally never freed, tasks may outlive the pool during shutdown
+            std::atomic<TaskSlot*> _chunks[max_n_chunks] = {};
+            std::atomic<uint64_t> _n_slots = 0;
+
+            // lower 32 bit: index + 1 of first free slot, 0 if empty. upper 32 bit: tag
+            std::atomic<uint64_t> _free_head = 0;
+    };
+}
@@ -11,6 +11,7 @@
 #include <unordered_map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <array>
 
@@ -65,7 +66,7 @@ namespace jluna::detail
     template<>
     struct as_julia_type_aux<uint16_t>
     {
-        static inline const std::string type_name = "UInt8";
+        static inline const std::string type_name = "UInt16";
     };
 
     template<>
@@ -98,6 +99,12 @@ namespace jluna::detail
         static inline const std::string type_name = "String";
     };
 
+    template<>
+    struct as_julia_type_aux<std::string_view>
+    {
+        static inline const std::string type_name = "String";
+    };
+
     template<>
     struct as_julia_type_aux<jl_value_t*>
     {
@@ -128,6 +135,12 @@ namespace jluna::detail
         static inline const std::string type_name = "Array";
     };
 
+    template<>
+    struct as_julia_type_aux<void*>
+    {
+        static inline const std::string type_name = "Ptr{Cvoid}";
+    };
+
     template<typename Value_t>
     struct as_julia_type_aux<std::complex<Value_t>>
     {
@@ -5,6 +5,8 @@
 
 #include <.src/common.hpp>
 
+#include <cstring>
+
 namespace jluna
 {
     namespace detail
@@ -179,114 +181,159 @@ namespace jluna
     template<is<std::string> T>
     T unbox(unsafe::Value* value)
     {
+        if (jl_is_string(value))
+            return std::string(jl_string_data(value), jl_string_len(value));
+
         return std::string(detail::to_string(value));
     }
 
+    template<is<std::string_view> T>
+    T unbox(unsafe::Value* value)
+    {
+        // symbols are never garbage collected, so their name can be aliased indefinitely
+        if (jl_is_symbol(value))
+            return std::string_view(jl_symbol_name((unsafe::Symbol*) value));
+
+        detail::assert_type((unsafe::DataType*) jl_typeof(value), jl_string_type);
+        return std::string_view(jl_string_data(value), jl_string_len(value));
+    }
+
     template<typename T, typename Value_t, std::enable_if_t<std::is_same_v<T, std::complex<Value_t>>, bool>>
     T unbox(unsafe::Value* value)
     {
-        gc_pause;
+        if constexpr (is_complex_layout_compatible<Value_t>)
+        {
+            // layout matches, read the value directly instead of converting
+            static_assert(sizeof(T) == 2 * sizeof(Value_t));
+            if (jl_typeof(value) == (unsafe::Value*) as_julia_type<T>::type())
+                return *reinterpret_cast<T*>(value);
+        }
+
         static auto* type = (jl_datatype_t*) jl_eval_string(("return " + as_julia_type<std::complex<Value_t>>::type_name).c_str());
-        auto* res = detail::convert(type, value);
 
-        auto* re = jl_get_nth_field(res, 0);
-        auto* im = jl_get_nth_field(res, 1);
+        auto scope = detail::GCRootScope();
+        auto* res = detail::gc_save(detail::convert(type, value));
+        auto* re = detail::gc_save(jl_get_nth_field(res, 0));
+        auto* im = detail::gc_save(jl_get_nth_field(res, 1));
 
-        auto out = std::complex<Value_t>(unbox<Value_t>(re), unbox<Value_t>(im));
-        gc_unpause;
-        return out;
+        return std::complex<Value_t>(unbox<Value_t>(re), unbox<Value_t>(im));
     }
 
     template<typename T, typename Value_t, std::enable_if_t<std::is_same_v<T, std::vector<Value_t>>, bool>>
     T unbox(unsafe::Value* value)
     {
-        gc_pause;
         auto* in = (jl_array_t*) value;
 
+        if constexpr (is_isbits_compatible<Value_t> and not std::is_same_v<Value_t, bool>)
+        {
+            // value type matches C++-side layout, copy in bulk instead of unboxing each element
+            if (jl_is_array(value) and jl_array_eltype(value) == (unsafe::Value*) as_julia_type<Value_t>::type())
+            {
+                std::vector<Value_t> out(in->length);
+                std::memcpy(out.data(), in->data, in->length * sizeof(Value_t));
+                return out;
+            }
+        }
+        else if constexpr (is_usertype<Value_t> and std::is_trivially_copyable_v<Value_t>)
+        {
+            if (Usertype<Value_t>::is_isbits() and jl_is_array(value) and jl_array_eltype(value) == (unsafe::Value*) as_julia_type<Value_t>::type())
+            {
+                std::vector<Value_t> out(in->length);
+                std::memcpy(out.data(), in->data, in->length * sizeof(Value_t));
+                return out;
+            }
+        }
+
+        auto scope = detail::GCRootScope();
+        detail::gc_push(value);
+
         std::vector<Value_t> out;
         out.reserve(in->length);
 
         for (uint64_t i = 0; i < in->length; ++i)
             out.emplace_back(unbox<Value_t>(jl_arrayref(in, i)));
 
-        gc_unpause;
         return out;
     }
 
-    template<typename T, typename Key_t, typename Value_t, std::enable_if_t<std::is_same_v<T, std::map<Key_t, Value_t>>, bool>>
-    T unbox(unsafe::Value* value)
+    namespace detail
     {
-        static jl_function_t* iterate = jl_get_function(jl_base_module, "iterate");
-
-        gc_pause;
-        auto out = std::map<Key_t, Value_t>();
-        auto* it_res = jl_nothing;
+        // element type of arrays requested from Julia when unboxing a collection: if the C++-side layout matches, convert Julia-side so
+        // the result can be copied in bulk, otherwise keep the original values and unbox each element
+        template<typename T>
+        unsafe::Value* serialized_element_type()
+        {
+            if constexpr (is_isbits_compatible<T>)
+                return (unsafe::Value*) as_julia_type<T>::type();
+            else
+                return (unsafe::Value*) jl_any_type;
+        }
 
-        unsafe::Value* next_i = jl_box_int64(1);
-        while(true)
+        // unbox dict into two parallel vectors of keys and values, using a single Julia-side call
+        template<typename Key_t, typename Value_t>
+        std::pair<std::vector<Key_t>, std::vector<Value_t>> unbox_keys_values(unsafe::Value* value)
         {
-            it_res = jl_call2(iterate, value, next_i);
-            if (it_res == jl_nothing)
-                break;
+            static jl_function_t* serialize_keys_values = unsafe::get_function("jluna"_sym, "serialize_keys_values"_sym);
+
+            auto scope = GCRootScope();
+            gc_push(value);
 
-            out.insert(unbox<std::pair<Key_t, Value_t>>(jl_get_nth_field(it_res, 0)));
-            next_i = jl_get_nth_field(it_res, 1);
+            auto* serialized = gc_save(safe_call(serialize_keys_values, value, serialized_element_type<Key_t>(), serialized_element_type<Value_t>()));
+            return {
+                unbox<std::vector<Key_t>>(jl_get_nth_field(serialized, 0)),
+                unbox<std::vector<Value_t>>(jl_get_nth_field(serialized, 1))
+            };
         }
+    }
+
+    template<typename T, typename Key_t, typename Value_t, std::enable_if_t<std::is_same_v<T, std::map<Key_t, Value_t>>, bool>>
+    T unbox(unsafe::Value* value)
+    {
+        auto [keys, values] = detail::unbox_keys_values<Key_t, Value_t>(value);
+
+        auto out = std::map<Key_t, Value_t>();
+        for (uint64_t i = 0; i < keys.size(); ++i)
+            out.emplace(std::move(keys[i]), std::move(values[i]));
 
-        gc_unpause;
         return out;
     }
 
     template<typename T, typename Key_t, typename Value_t, std::enable_if_t<std::is_same_v<T, std::unordered_map<Key_t, Value_t>>, bool>>
     T unbox(unsafe::Value* value)
     {
-        static jl_function_t* iterate = jl_get_function(jl_base_module, "iterate");
+        auto [keys, values] = detail::unbox_keys_values<Key_t, Value_t>(value);
 
-        gc_pause;
         auto out = std::unordered_map<Key_t, Value_t>();
-        auto* it_res = jl_nothing;
+        out.reserve(keys.size());
 
-        unsafe::Value* next_i = jl_box_int64(1);
-        while(true)
-        {
-            it_res = jl_call2(iterate, value, next_i);
-            if (it_res == jl_nothing)
-                break;
-
-            out.insert(unbox<std::pair<Key_t, Value_t>>(jl_get_nth_field(it_res, 0)));
-            next_i = jl_get_nth_field(it_res, 1);
-        }
+        for (uint64_t i = 0; i < keys.size(); ++i)
+            out.emplace(std::move(keys[i]), std::move(values[i]));
 
-        gc_unpause;
         return out;
     }
 
     template<typename T, typename Value_t, std::enable_if_t<std::is_same_v<T, std::set<Value_t>>, bool>>
     T unbox(unsafe::Value* value)
     {
-        gc_pause;
-        static jl_function_t* serialize = unsafe::get_function("jluna"_sym, "serialize"_sym);
-        auto* as_array = (jl_array_t*) jl_call1(serialize, value);
+        static jl_function_t* serialize_values = unsafe::get_function("jluna"_sym, "serialize_values"_sym);
 
-        T out;
-        for (uint64_t i = 0; i < jl_array_len(as_array); ++i)
-            out.insert(unbox<Value_t>(jl_arrayref(as_array, i)));
+        auto scope = detail::GCRootScope();
+        detail::gc_push(value);
 
-        gc_unpause;
-        return out;
+        auto* serialized = detail::gc_save(safe_call(serialize_values, value, detail::serialized_element_type<Value_t>()));
+        auto values = unbox<std::vector<Value_t>>(serialized);
+
+        return T(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
     }
 
     template<is_pair T>
     T unbox(unsafe::Value* value)
     {
-        gc_pause;
+        auto scope = detail::GCRootScope();
+        auto* first = detail::gc_save(jl_get_nth_field(value, 0));
+        auto* second = detail::gc_save(jl_get_nth_field(value, 1));
 
-        auto* first = jl_get_nth_field(value, 0);
-        auto* second = jl_get_nth_field(value, 1);
-
-        jluna::is_pair auto out = T(unbox<typename T::first_type>(first), unbox<typename T::second_type>(second));
-        gc_unpause;
-        return out;
+        return T(unbox<typename T::first_type>(first), unbox<typename T::second_type>(second));
     }
 
     namespace detail    // helper functions for tuple unboxing
@@ -5,6 +5,11 @@
 
 #include <include/unsafe_utilities.hpp>
 
+#include <atomic>
+#include <stdexcept>
+#include <cassert>
+#include <mutex>
+
 namespace jluna
 {
     unsafe::Symbol* operator""_sym(const char* str, uint64_t)
@@ -101,6 +106,120 @@ namespace jluna::unsafe
         return jl_gc_is_enabled();
     }
 
+    namespace
+    {
+        // per-thread, as jl_gc_enable only affects the calling thread. Tasks may not yield while paused, c.f. GCPause
+        thread_local uint64_t _gc_pause_depth = 0;
+        thread_local bool _gc_was_enabled = false;
+        thread_local std::chrono::steady_clock::time_point _gc_pause_start;
+        thread_local GCPause* _gc_pause_innermost = nullptr;
+
+        std::atomic<uint64_t> _gc_pause_count = 0;
+        std::atomic<uint64_t> _gc_pause_total_ns = 0;
+        std::atomic<uint64_t> _gc_pause_max_ns = 0;
+
+        std::atomic<bool> _gc_pause_tracking = false;
+        std::mutex _gc_pause_per_location_lock;
+        std::map<std::string, std::chrono::nanoseconds> _gc_pause_per_location;
+    }
+
+    GCPause::GCPause(const char* file, uint64_t line)
+        : _file(file), _line(line), _previous(_gc_pause_innermost), _thread_id(std::this_thread::get_id())
+    {
+        if (not jluna::detail::is_julia_thread())
+            throw std::runtime_error("In jluna::unsafe::GCPause: the calling thread is not known to Julia, the GC can only be paused from the main thread or from within a task");
+
+        _gc_pause_innermost = this;
+
+        if (_gc_pause_depth++ == 0)
+        {
+            _gc_was_enabled = jl_gc_is_enabled();
+            jl_gc_enable(false);
+            _gc_pause_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    GCPause::~GCPause()
+    {
+        release();
+    }
+
+    void GCPause::release_innermost()
+    {
+        if (_gc_pause_innermost != nullptr)
+            _gc_pause_innermost->release();
+    }
+
+    void GCPause::release()
+    {
+        if (_released)
+            return;
+
+        // the task yielded and resumed on a different thread, whose GC state and pause depth this guard does not own
+        assert(std::this_thread::get_id() == _thread_id and "In jluna::unsafe::GCPause: task yielded while the GC was paused");
+
+        _released = true;
+
+        // usually the innermost guard, unless guards are released out of order
+        GCPause** link = &_gc_pause_innermost;
+        while (*link != nullptr and *link != this)
+            link = &(*link)->_previous;
+
+        if (*link == this)
+            *link = _previous;
+
+        if (--_gc_pause_depth != 0)
+            return;
+
+        uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _gc_pause_start).count();
+
+        _gc_pause_count.fetch_add(1, std::memory_order_relaxed);
+        _gc_pause_total_ns.fetch_add(duration, std::memory_order_relaxed);
+
+        uint64_t max = _gc_pause_max_ns.load(std::memory_order_relaxed);
+        while (duration > max and not _gc_pause_max_ns.compare_exchange_weak(max, duration, std::memory_order_relaxed));
+
+        if (_gc_pause_tracking.load(std::memory_order_relaxed))
+        {
+            auto location = std::string(_file) + ":" + std::to_string(_line);
+            std::lock_guard<std::mutex> guard(_gc_pause_per_location_lock);
+            _gc_pause_per_location[location] += std::chrono::nanoseconds(duration);
+        }
+
+        if (_gc_was_enabled)
+        {
+            jl_gc_enable(true);
+            jl_gc_safepoint();
+        }
+    }
+
+    GCPauseStatistics get_gc_pause_statistics()
+    {
+        GCPauseStatistics out;
+        out.n_pauses = _gc_pause_count.load();
+        out.total_duration = std::chrono::nanoseconds(_gc_pause_total_ns.load());
+        out.max_duration = std::chrono::nanoseconds(_gc_pause_max_ns.load());
+
+        std::lock_guard<std::mutex> guard(_gc_pause_per_location_lock);
+        out.duration_per_location = _gc_pause_per_location;
+        return out;
+    }
+
+    void reset_gc_pause_statistics()
+    {
+        _gc_pause_count = 0;
+        _gc_pause_total_ns = 0;
+        _gc_pause_max_ns = 0;
+
+        std::lock_guard<std::mutex> guard(_gc_pause_per_location_lock);
+        _gc_pause_per_location.clear();
+    }
+
+    void set_gc_pause_tracking(bool enabled)
+    {
+        _gc_pause_tracking = enabled;
+    }
+
     uint64_t get_array_size(unsafe::Array* array)
     {
         return array->length;
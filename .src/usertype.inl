@@ -5,6 +5,9 @@
 
 #include <include/exceptions.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 namespace jluna
 {
     template<typename T>
@@ -35,15 +38,43 @@ namespace jluna
         if (_mapping.find(name) == _mapping.end())
             _fieldnames_in_order.push_back(symbol);
 
-        _mapping.insert({symbol, {
+        _mapping.insert_or_assign(symbol, std::make_tuple(
             [box_get](T& instance) -> unsafe::Value* {
                 return jluna::box<Field_t>(box_get(instance));
             },
             [unbox_set](T& instance, unsafe::Value* value) -> void {
                 unbox_set(instance, jluna::unbox<Field_t>(value));
             },
-            Type((jl_datatype_t*) jl_eval_string(as_julia_type<Field_t>::type_name.c_str()))
-        }});
+            Type((jl_datatype_t*) jl_eval_string(as_julia_type<Field_t>::type_name.c_str())),
+            std::optional<uint64_t>()
+        ));
+    }
+
+    template<typename T>
+    template<typename Field_t>
+    void Usertype<T>::add_field(const std::string& name, Field_t T::* member)
+    {
+        if (_name.get() == nullptr)
+            initialize();
+
+        auto symbol = Symbol(name);
+
+        if (_mapping.find(name) == _mapping.end())
+            _fieldnames_in_order.push_back(symbol);
+
+        const auto default_instance = T();
+        const uint64_t offset = reinterpret_cast<const char*>(&(default_instance.*member)) - reinterpret_cast<const char*>(&default_instance);
+
+        _mapping.insert_or_assign(symbol, std::make_tuple(
+            [member](T& instance) -> unsafe::Value* {
+                return jluna::box<Field_t>(instance.*member);
+            },
+            [member](T& instance, unsafe::Value* value) -> void {
+                instance.*member = jluna::unbox<Field_t>(value);
+            },
+            Type((jl_datatype_t*) jl_eval_string(as_julia_type<Field_t>::type_name.c_str())),
+            std::optional<uint64_t>(offset)
+        ));
     }
 
     template<typename T>
@@ -77,6 +108,58 @@ namespace jluna
 
         _type = std::make_unique<Type>((jl_datatype_t*) jluna::safe_call(implement, template_proxy, module));
         _implemented = true;
+        _isbits = false;
+        gc_unpause;
+    }
+
+    template<typename T>
+    void Usertype<T>::implement_as_isbits(unsafe::Module* module)
+    {
+        static_assert(std::is_trivially_copyable_v<T> and std::is_standard_layout_v<T>, "types implemented as isbits need to be trivially copyable and have standard layout");
+
+        if (_name.get() == nullptr)
+            initialize();
+
+        // julia-side fields are declared in memory order, regardless of the order in which they were added
+        std::vector<std::pair<uint64_t, Symbol>> fields;
+        for (auto& field_name : _fieldnames_in_order)
+        {
+            auto& offset = std::get<3>(_mapping.at(field_name));
+            if (not offset.has_value())
+                throw std::invalid_argument("In jluna::Usertype<" + get_name() + ">::implement_as_isbits: field " + std::string(jl_symbol_name(field_name)) + " was not added through add_field");
+
+            fields.emplace_back(offset.value(), field_name);
+        }
+
+        std::stable_sort(fields.begin(), fields.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+
+        gc_pause;
+        static jl_function_t* implement_isbits = unsafe::get_function("jluna"_sym, "implement_isbits"_sym);
+
+        auto* names = unsafe::new_array((unsafe::Value*) jl_symbol_type, fields.size());
+        auto* types = unsafe::new_array((unsafe::Value*) jl_any_type, fields.size());
+        auto offsets = std::vector<UInt64>();
+
+        for (uint64_t i = 0; i < fields.size(); ++i)
+        {
+            jl_arrayset(names, (unsafe::Value*) fields.at(i).second, i);
+            jl_arrayset(types, (unsafe::Value*) std::get<2>(_mapping.at(fields.at(i).second)), i);
+            offsets.push_back(fields.at(i).first);
+        }
+
+        _type = std::make_unique<Type>((jl_datatype_t*) jluna::safe_call(
+            implement_isbits,
+            _name->operator unsafe::Value*(),
+            names,
+            types,
+            jluna::box<std::vector<UInt64>>(offsets),
+            jluna::box<UInt64>(sizeof(T)),
+            module
+        ));
+        _implemented = true;
+        _isbits = true;
         gc_unpause;
     }
 
@@ -86,12 +169,25 @@ namespace jluna
         return _implemented;
     }
 
+    template<typename T>
+    bool Usertype<T>::is_isbits()
+    {
+        return _isbits;
+    }
+
     template<typename T>
     unsafe::Value* Usertype<T>::box(T& in)
     {
         if (not _implemented)
             implement();
 
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            // layout was verified during implement_as_isbits, copy the instance as a whole
+            if (_isbits)
+                return jl_new_bits(_type->operator unsafe::Value*(), &in);
+        }
+
         gc_pause;
         static jl_function_t* setfield = jl_get_function(jl_base_module, "setfield!");
 
@@ -110,6 +206,16 @@ namespace jluna
         if (not _implemented)
             implement();
 
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            if (_isbits and jl_typeof(in) == _type->operator unsafe::Value*())
+            {
+                auto out = T();
+                std::memcpy(&out, in, sizeof(T));
+                return out;
+            }
+        }
+
         gc_pause;
         static jl_function_t* getfield = jl_get_function(jl_base_module, "getfield");
 
@@ -8,6 +8,7 @@
 #include <include/multi_threading.hpp>
 #include <include/box.hpp>
 #include <chrono>
+#include <numeric>
 #include <.src/cppcall.inl>
 
 using namespace jluna;
@@ -20,6 +21,24 @@ struct NonJuliaType
 set_usertype_enabled(NonJuliaType);
 make_usertype_implicitly_convertible(NonJuliaType);
 
+struct IsbitsType
+{
+    Int32 _first = 1;
+    Float64 _second = 2;
+    bool _third = true;
+};
+set_usertype_enabled(IsbitsType);
+make_usertype_implicitly_convertible(IsbitsType);
+
+// char is 1 byte C++-side, but maps to the 4-byte Char Julia-side
+struct MismatchedIsbitsType
+{
+    char _first = 'a';
+    char _second = 'b';
+    Int32 _third = 0;
+};
+set_usertype_enabled(MismatchedIsbitsType);
+
 #include <thread>
 
 int main()
@@ -46,6 +65,124 @@ int main()
         gc_pop(1);
     });
 
+    Test::test("unsafe: gc root scope", [](){
+
+        auto before = detail::gc_root_stack().size();
+        {
+            auto scope = detail::GCRootScope();
+
+            std::vector<unsafe::Value*> pushed;
+            for (uint64_t i = 0; i < 1000; ++i)
+            {
+                pushed.push_back(jl_eval_string("return [123, 434, 342]"));
+                detail::gc_push(pushed.back());
+            }
+
+            collect_garbage();
+
+            auto after = unbox<std::vector<uint64_t>>(detail::gc_save(jl_eval_string("return [1, 2, 3]")));
+            Test::assert_that(after.at(2) == 3);
+            Test::assert_that(detail::gc_root_stack().size() == before + 1001);
+
+            for (auto* value : pushed)
+            {
+                auto vec = unbox<std::vector<uint64_t>>(value);
+                Test::assert_that(vec.size() == 3 and vec.at(0) == 123 and vec.at(1) == 434 and vec.at(2) == 342);
+            }
+        }
+
+        Test::assert_that(detail::gc_root_stack().size() == before);
+    });
+
+    Test::test("unsafe: gc root scope per task", [](){
+
+        auto before = detail::gc_root_stack().size();
+
+        auto task = ThreadPool::create<bool()>([]() -> bool {
+
+            auto task_before = detail::gc_root_stack().size();
+            auto scope = detail::GCRootScope();
+            auto* value = detail::gc_save(jl_eval_string("return [123, 434, 342]"));
+
+            // task may resume on a different thread, its values stay rooted regardless
+            jl_eval_string("yield()");
+            collect_garbage();
+
+            auto vec = unbox<std::vector<uint64_t>>(value);
+            return detail::gc_root_stack().size() == task_before + 1 and vec.at(2) == 342;
+        });
+
+        task.schedule();
+        task.join();
+
+        Test::assert_that(task.result().get().value());
+        Test::assert_that(detail::gc_root_stack().size() == before);
+    });
+
+    Test::test("unsafe: gc root scope nested in task", [](){
+
+        // boxing a map opens a scope that pushes nothing before boxing its keys and values in nested scopes
+        auto task = ThreadPool::create<bool()>([]() -> bool {
+
+            auto map = std::map<std::string, std::string>{{"abc", "def"}, {"ghi", "jkl"}};
+            bool all_equal = true;
+
+            for (uint64_t i = 0; i < 100; ++i)
+            {
+                auto scope = detail::GCRootScope();
+                auto* boxed = detail::gc_save(box<std::map<std::string, std::string>>(map));
+                collect_garbage();
+
+                all_equal = all_equal and unbox<std::map<std::string, std::string>>(boxed) == map;
+            }
+
+            return all_equal;
+        });
+
+        task.schedule();
+        task.join();
+
+        Test::assert_that(task.result().get().value());
+    });
+
+    Test::test("unsafe: gc_pause nesting", [](){
+
+        Test::assert_that(unsafe::gc_is_enabled());
+        unsafe::reset_gc_pause_statistics();
+        {
+            gc_pause;
+            {
+                gc_pause;
+                gc_unpause;
+                Test::assert_that(not unsafe::gc_is_enabled());
+            }
+            Test::assert_that(not unsafe::gc_is_enabled());
+        }
+
+        Test::assert_that(unsafe::gc_is_enabled());
+        Test::assert_that(unsafe::get_gc_pause_statistics().n_pauses == 1);
+
+        {
+            gc_pause;
+            gc_pause;
+            gc_unpause;
+            Test::assert_that(not unsafe::gc_is_enabled());
+            gc_unpause;
+            Test::assert_that(unsafe::gc_is_enabled());
+        }
+
+        Test::assert_that(unsafe::gc_is_enabled());
+
+        try
+        {
+            gc_pause;
+            throw std::runtime_error("");
+        }
+        catch (...) {}
+
+        Test::assert_that(unsafe::gc_is_enabled());
+    });
+
     Test::test("unsafe: gc", []() {
 
         auto* value = jl_eval_string("return [123, 434, 342]");
@@ -399,6 +536,48 @@ int main()
         });
     });
 
+    Test::test("safe_call: exception message", []() {
+
+        auto* throw_error = jl_eval_string("return () -> throw(ErrorException(\"lazy exception message\"))");
+
+        try
+        {
+            safe_call(throw_error);
+            Test::assert_that(false);
+        }
+        catch (const JuliaException& e)
+        {
+            Test::assert_that(std::string(e.what()).find("lazy exception message") != std::string::npos);
+            Test::assert_that(jl_isa((unsafe::Value*) const_cast<JuliaException&>(e), (unsafe::Value*) jl_errorexception_type));
+        }
+    });
+
+    Test::test("safe_call: exception destroyed off-thread", []() {
+
+        auto* throw_error = jl_eval_string("return () -> throw(ErrorException(\"off-thread\"))");
+
+        std::exception_ptr caught = nullptr;
+        try
+        {
+            safe_call(throw_error);
+        }
+        catch (...)
+        {
+            caught = std::current_exception();
+        }
+
+        collect_garbage();
+
+        // the thread is not known to Julia, the release is deferred to the next exception
+        std::thread([caught = std::move(caught)]() mutable {
+            caught = nullptr;
+        }).join();
+
+        Test::assert_that_throws<JuliaException>([&]() {
+            safe_call(throw_error);
+        });
+    });
+
     Test::test("safe_eval", []() {
         Test::assert_that_throws<JuliaException>([]() {
             safe_eval("throw(ErrorException(\"abc\"))");
@@ -447,9 +626,149 @@ int main()
     };
 
     test_box_unbox_iterable("Vector", std::vector<uint64_t>{1, 2, 3, 4});
+    test_box_unbox_iterable("Vector{Float32}", std::vector<float>{1.5, 2, 3, 4});
+    test_box_unbox_iterable("Vector{ComplexF64}", std::vector<std::complex<double>>{{1, 2}, {3, 4}});
+    test_box_unbox_iterable("Vector{String}", std::vector<std::string>{"abc", "def"});
     test_box_unbox_iterable("Dict", std::map<uint64_t, std::string>{{12, "abc"}});
     test_box_unbox_iterable("Dict", std::unordered_map<uint64_t, std::string>{{12, "abc"}});
     test_box_unbox_iterable("Set", std::set<uint64_t>{1, 2, 3, 4});
+    test_box_unbox_iterable("Dict{Int32, Float64}", std::unordered_map<Int32, Float64>{{1, 1.5}, {-2, 3}, {100, -4}});
+    test_box_unbox_iterable("Set{String}", std::set<std::string>{"abc", "def"});
+
+    Test::test("box Dict: bulk", []() {
+
+        std::map<Int64, Float32> value;
+        for (Int64 i = 0; i < 10000; ++i)
+            value.insert({i * i, i * 0.5f});
+
+        auto scope = detail::GCRootScope();
+        auto* boxed = detail::gc_save(box<std::map<Int64, Float32>>(value));
+        Test::assert_that(jl_typeof(boxed) == jl_eval_string("return Dict{Int64, Float32}"));
+        Test::assert_that(unbox<Int64>(jl_call1(jl_get_function(jl_base_module, "length"), boxed)) == 10000);
+        Test::assert_that(unbox<std::map<Int64, Float32>>(boxed) == value);
+
+        auto* empty = box<std::set<Int32>>(std::set<Int32>());
+        Test::assert_that(jl_typeof(empty) == jl_eval_string("return Set{Int32}"));
+    });
+
+    Test::test("unbox Dict: bulk", []() {
+
+        auto scope = detail::GCRootScope();
+        auto* dict = detail::gc_save(jl_eval_string("return Dict{Int32, Float64}(Int32(i) => i * 0.5 for i in 1:10000)"));
+
+        auto as_map = unbox<std::map<Int64, Float32>>(dict);
+        Test::assert_that(as_map.size() == 10000 and as_map.at(1234) == 617.f);
+
+        auto as_unordered = unbox<std::unordered_map<Int32, Float64>>(dict);
+        Test::assert_that(as_unordered.size() == 10000 and as_unordered.at(10000) == 5000);
+
+        auto* strings = detail::gc_save(jl_eval_string("return Dict(\"abc\" => [1, 2], \"def\" => Int64[])"));
+        auto as_vectors = unbox<std::map<std::string, std::vector<Int64>>>(strings);
+        Test::assert_that(as_vectors.at("abc") == std::vector<Int64>{1, 2} and as_vectors.at("def").empty());
+
+        auto* set = detail::gc_save(jl_eval_string("return Set{UInt8}([1, 2, 3, 255])"));
+        Test::assert_that(unbox<std::set<UInt64>>(set) == std::set<UInt64>{1, 2, 3, 255});
+
+        Test::assert_that_throws<JuliaException>([&](){
+            unbox<std::map<std::string, Float64>>(strings);
+        });
+    });
+
+    Test::test("box/unbox Complex: direct", []() {
+
+        auto scope = detail::GCRootScope();
+
+        auto* f32 = detail::gc_save(box<std::complex<float>>({1.5f, -2.f}));
+        Test::assert_that(jl_typeof(f32) == jl_eval_string("return ComplexF32"));
+        Test::assert_that(unbox<std::complex<float>>(f32) == std::complex<float>(1.5f, -2.f));
+
+        auto* i32 = detail::gc_save(box<std::complex<Int32>>({3, 4}));
+        Test::assert_that(jl_typeof(i32) == jl_eval_string("return Complex{Int32}"));
+        Test::assert_that(unbox<std::complex<Int32>>(i32) == std::complex<Int32>(3, 4));
+
+        // conversion
+        Test::assert_that(unbox<std::complex<double>>(f32) == std::complex<double>(1.5, -2));
+        Test::assert_that(unbox<std::complex<double>>(jl_box_float64(3)) == std::complex<double>(3, 0));
+
+        // aliasing the memory of a std::vector
+        auto data = std::vector<std::complex<double>>{{1, 2}, {3, 4}};
+        auto aliased = Array<std::complex<double>, 1>(data.data(), data.size());
+        safe_call(unsafe::get_function(jl_base_module, "setindex!"_sym), aliased.operator unsafe::Value*(), box<std::complex<double>>({5, 6}), box<Int64>(1));
+        Test::assert_that(data.at(0) == std::complex<double>(5, 6));
+        Test::assert_that(aliased.as_span().data() == data.data());
+    });
+
+    Test::test("box/unbox String: views and interning", []() {
+
+        auto scope = detail::GCRootScope();
+
+        // embedded null
+        auto with_null = std::string("ab\0cd", 5);
+        auto* boxed = detail::gc_save(box<std::string>(with_null));
+        Test::assert_that(jl_string_len(boxed) == 5);
+        Test::assert_that(unbox<std::string>(boxed) == with_null);
+
+        auto view = unbox<std::string_view>(boxed);
+        Test::assert_that(view == with_null and view.data() == jl_string_data(boxed));
+
+        Test::assert_that(unbox<std::string_view>(jl_eval_string("return :symbol_name")) == "symbol_name");
+        Test::assert_that_throws<JuliaException>([](){
+            unbox<std::string_view>(jl_box_int64(1234));
+        });
+
+        auto* from_view = detail::gc_save(box<std::string_view>(std::string_view("abcdef").substr(1, 3)));
+        Test::assert_that(unbox<std::string>(from_view) == "bcd");
+        Test::assert_that(unbox<std::string>(box<const char*>("abc")) == "abc");
+
+        Proxy proxy = Main.safe_eval("return \"abc\"");
+        Test::assert_that(static_cast<std::string_view>(proxy) == "abc");
+        Test::assert_that(static_cast<std::string>(Main.safe_eval("return 1234")) == "1234");
+
+        auto* interned = box_interned("key");
+        Test::assert_that(box_interned(std::string("key")) == interned);
+        Test::assert_that(box_interned("other_key") != interned);
+        Test::assert_that(unbox<std::string>(interned) == "key");
+
+        auto long_key = std::string(100, 'a');
+        auto* long_interned = detail::gc_save(box_interned(long_key));
+        Test::assert_that(box_interned(long_key) != long_interned);
+
+        clear_interned_strings();
+        Test::assert_that(box_interned("key") != nullptr);
+    });
+
+    Test::test("unbox Vector: value type conversion", []() {
+
+        auto* as_int32 = jl_eval_string("return Int32[1, 2, 3]");
+        auto unboxed = unbox<std::vector<Int64>>(as_int32);
+        Test::assert_that(unboxed == std::vector<Int64>{1, 2, 3});
+
+        auto* boxed = box<std::vector<UInt16>>(std::vector<UInt16>{1, 2, 3});
+        Test::assert_that(jl_array_eltype(boxed) == (unsafe::Value*) jl_uint16_type);
+    });
+
+    Test::test("box Vector: move", []() {
+
+        auto to_move = std::vector<Float64>{1, 2, 3, 4};
+        const auto* data = to_move.data();
+
+        auto scope = detail::GCRootScope();
+        auto* boxed = detail::gc_save(box<std::vector<Float64>>(std::move(to_move)));
+
+        // the array uses the memory of the vector instead of a copy
+        Test::assert_that(((jl_array_t*) boxed)->data == data);
+        Test::assert_that(unbox<std::vector<Float64>>(boxed) == std::vector<Float64>{1, 2, 3, 4});
+
+        // memory stays valid if the array is resized Julia-side, then is freed once the array is collected
+        auto* push = unsafe::get_function(jl_base_module, "push!"_sym);
+        safe_call(push, boxed, box<Float64>(5));
+        Test::assert_that(unbox<std::vector<Float64>>(boxed).back() == 5);
+
+        auto* empty = detail::gc_save(box<std::vector<Float64>>(std::vector<Float64>()));
+        Test::assert_that(((jl_array_t*) empty)->length == 0);
+
+        collect_garbage();
+    });
 
     Test::test("make_new_named_undef", []() {
 
@@ -579,6 +898,51 @@ int main()
         // 2 bc symbol and value are registered, even for unnamed
     });
 
+    Test::test("proxy: reference slots are reused", []() {
+
+        jl_value_t * val = jl_eval_string("return [1, 2, 3, 4]");
+        {
+            auto proxy = Proxy(val, nullptr);
+        }
+
+        auto n_slots = jl_unbox_uint64(jl_eval_string("return sum(table -> table._n_slots, jluna.memory_handler._refs[]._shards)"));
+        for (size_t i = 0; i < 10; ++i)
+            auto proxy = Proxy(val, nullptr);
+
+        Test::assert_that(jl_unbox_uint64(jl_eval_string("return sum(table -> table._n_slots, jluna.memory_handler._refs[]._shards)")) == n_slots);
+    });
+
+    Test::test("proxy: stale reference keys are rejected", []() {
+
+        auto scope = detail::GCRootScope();
+        auto* val = detail::gc_save(jl_eval_string("return [1, 2, 3, 4]"));
+
+        auto key = detail::create_reference(val);
+        detail::free_reference(key);
+        detail::free_reference(key);
+
+        // reuses the slot of key
+        auto other = detail::create_reference(val);
+        Test::assert_that(other != key);
+
+        bool thrown = false;
+        try
+        {
+            detail::get_reference(key);
+        }
+        catch (const std::invalid_argument&)
+        {
+            thrown = true;
+        }
+        Test::assert_that(thrown);
+
+        // must not free the slot now owned by other
+        detail::free_reference(key);
+        Test::assert_that(jl_get_nth_field(detail::get_reference(other), 0) == val);
+
+        detail::free_reference(other);
+    });
+
     Test::test("proxy inheritance dtor", []() {
 
         Main.safe_eval(R"(
@@ -1089,7 +1453,62 @@ int main()
 
         Test::assert_that(Main.safe_eval("test(100) == 111").operator bool());
     });
-    
+
+    Test::test("C: typed call", []() {
+
+        Main.create_or_assign("test_typed", as_julia_function<double(double, int32_t)>([](double a, int32_t b) {
+            return a * b;
+        }));
+
+        Main.create_or_assign("test_pointer", as_julia_function<void*(void*)>([](void* ptr) {
+            return ptr;
+        }));
+
+        Test::assert_that(Main.safe_eval("test_typed isa jluna.cppcall.TypedUnnamedFunction{Float64, Tuple{Float64, Int32}}").operator bool());
+        Test::assert_that(Main.safe_eval("test_typed(1.5, 2) === 3.0").operator bool());
+        Test::assert_that(Main.safe_eval("test_pointer(Ptr{Cvoid}(1234)) == Ptr{Cvoid}(1234)").operator bool());
+
+        bool thrown = false;
+        try
+        {
+            Main.safe_eval("test_typed(1.5)");
+        }
+        catch (JuliaException&)
+        {
+            thrown = true;
+        }
+
+        Test::assert_that(thrown);
+    });
+
+    Test::test("C: call with n > 3 args", []() {
+
+        Main.create_or_assign("test_three", as_julia_function<Int64(Int64, Int64, Int64)>([](Int64 a, Int64 b, Int64 c) {
+            return a + b + c;
+        }));
+
+        Main.create_or_assign("test_six", as_julia_function<std::string(Int64, double, std::string, Int64, bool, std::vector<Int64>)>(
+            [](Int64 a, double b, std::string c, Int64 d, bool e, std::vector<Int64> f) {
+                return std::to_string(a + int(b) + d + f.size()) + c + (e ? "true" : "false");
+            }
+        ));
+
+        Test::assert_that(Main.safe_eval("test_three(1, 2, 3) == 6").operator bool());
+        Test::assert_that(Main.safe_eval(R"(test_six(1, 2.0, "_", 3, true, [1, 2]) == "8_true")").operator bool());
+
+        bool thrown = false;
+        try
+        {
+            Main.safe_eval("test_six(1, 2, 3)");
+        }
+        catch (JuliaException&)
+        {
+            thrown = true;
+        }
+
+        Test::assert_that(thrown);
+    });
+
     Test::test("C: forward exception", []() {
 
         Main.create_or_assign("test", as_julia_function<Nothing()>([]() -> void {
@@ -1395,6 +1814,56 @@ int main()
         gc_unpause;
     });
 
+    Test::test("Usertype: isbits", []() {
+
+        Usertype<IsbitsType>::add_field("_third", &IsbitsType::_third);
+        Usertype<IsbitsType>::add_field("_first", &IsbitsType::_first);
+        Usertype<IsbitsType>::add_field("_second", &IsbitsType::_second);
+        Usertype<IsbitsType>::implement_as_isbits();
+
+        Test::assert_that(Usertype<IsbitsType>::is_implemented());
+        Test::assert_that(Usertype<IsbitsType>::is_isbits());
+        Test::assert_that(jl_unbox_bool(safe_eval("return isbitstype(IsbitsType)")));
+        Test::assert_that(jl_unbox_bool(safe_eval("return fieldnames(IsbitsType) == (:_first, :_second, :_third)")));
+
+        auto scope = detail::GCRootScope();
+        auto* boxed = detail::gc_save(box<IsbitsType>(IsbitsType{-12, 3.5, false}));
+        Test::assert_that(jl_unbox_int32(jl_get_nth_field(boxed, 0)) == -12);
+        Test::assert_that(jl_unbox_float64(jl_get_nth_field(boxed, 1)) == 3.5);
+        Test::assert_that(jl_unbox_bool(jl_get_nth_field(boxed, 2)) == false);
+
+        auto unboxed = unbox<IsbitsType>(boxed);
+        Test::assert_that(unboxed._first == -12 and unboxed._second == 3.5 and unboxed._third == false);
+
+        auto vec = std::vector<IsbitsType>{{1, 1.5, true}, {2, 2.5, false}, {3, 3.5, true}};
+        auto* boxed_vec = detail::gc_save(box<std::vector<IsbitsType>>(vec));
+        Test::assert_that(jl_array_eltype(boxed_vec) == safe_eval("return IsbitsType"));
+
+        auto unboxed_vec = unbox<std::vector<IsbitsType>>(boxed_vec);
+        Test::assert_that(unboxed_vec.size() == vec.size());
+        for (uint64_t i = 0; i < vec.size(); ++i)
+            Test::assert_that(unboxed_vec.at(i)._first == vec.at(i)._first and unboxed_vec.at(i)._second == vec.at(i)._second and unboxed_vec.at(i)._third == vec.at(i)._third);
+
+        Test::assert_that_throws<std::invalid_argument>([]() {
+            Usertype<IsbitsType>::add_property<Int32>("_fourth", [](IsbitsType& in) -> Int32 { return in._first; });
+            Usertype<IsbitsType>::implement_as_isbits();
+        });
+    });
+
+    Test::test("Usertype: isbits layout mismatch", []() {
+
+        Usertype<MismatchedIsbitsType>::add_field("_first", &MismatchedIsbitsType::_first);
+        Usertype<MismatchedIsbitsType>::add_field("_second", &MismatchedIsbitsType::_second);
+        Usertype<MismatchedIsbitsType>::add_field("_third", &MismatchedIsbitsType::_third);
+
+        Test::assert_that_throws<JuliaException>([]() {
+            Usertype<MismatchedIsbitsType>::implement_as_isbits();
+        });
+
+        Test::assert_that(not Usertype<MismatchedIsbitsType>::is_implemented());
+        Test::assert_that(not Usertype<MismatchedIsbitsType>::is_isbits());
+    });
+
     Test::test("jluna::Mutex", [](){
 
         auto mutex = jluna::Mutex();
@@ -1479,6 +1948,672 @@ int main()
         Test::assert_that((bool)task_proxy["sticky"] == false);
     });
 
+    Test::test("ThreadPool: create many", []()
+    {
+        for (Int64 i = 0; i < 1000; ++i)
+        {
+            auto task = ThreadPool::create<Int64()>([i]() -> Int64 {
+                return i;
+            });
+
+            task.schedule();
+            task.join();
+            Test::assert_that(task.result().get().value() == i);
+        }
+
+        // capture too large to be stored in-place
+        auto large = std::array<Int64, 128>();
+        large.fill(1);
+
+        std::vector<Task<Int64>> tasks;
+        for (uint64_t i = 0; i < 16; ++i)
+            tasks.push_back(ThreadPool::create<Int64()>([large]() -> Int64 {
+                Int64 sum = 0;
+                for (auto x : large)
+                    sum += x;
+                return sum;
+            }));
+
+        for (auto& task : tasks)
+            task.schedule();
+
+        for (auto& task : tasks)
+        {
+            task.join();
+            Test::assert_that(task.result().get().value() == 128);
+        }
+    });
+
+    Test::test("ThreadPool: create_batch", []()
+    {
+        auto tasks = ThreadPool::create_batch(1000, [](uint64_t i) -> Int64 {
+            return i * i;
+        });
+
+        Test::assert_that(tasks.size() == 1000);
+        ThreadPool::schedule_batch(tasks);
+
+        for (uint64_t i = 0; i < tasks.size(); ++i)
+        {
+            tasks.at(i).join();
+            Test::assert_that(tasks.at(i).result().get().value() == Int64(i * i));
+        }
+
+        std::atomic<uint64_t> n_invoked = 0;
+        auto void_tasks = ThreadPool::create_batch(100, [&](uint64_t) {
+            n_invoked += 1;
+        });
+
+        // invalidated tasks are skipped
+        auto moved = std::move(void_tasks.back());
+        ThreadPool::schedule_batch(void_tasks);
+
+        for (auto& task : void_tasks)
+            task.join();
+
+        Test::assert_that(n_invoked == 99);
+        Test::assert_that(not moved.is_running());
+        Test::assert_that(ThreadPool::create_batch(0, [](uint64_t) {}).empty());
+    });
+
+    Test::test("Future: then", []()
+    {
+        auto task = ThreadPool::create<Int64()>([]() -> Int64 {
+            return 4;
+        });
+
+        auto next = task.result().then([](Int64 x) -> std::string {
+            return std::to_string(x * 2);
+        });
+
+        task.schedule();
+        next.join();
+
+        Test::assert_that(next.result().get().value() == "8");
+        Test::assert_that(task.result().get().value() == 4);
+
+        // future already has a value
+        auto last = next.result().then([](std::string x) -> Int64 {
+            return std::stoi(x);
+        });
+
+        last.join();
+        Test::assert_that(last.result().get().value() == 8);
+
+        // only one continuation per future
+        Test::assert_that_throws<std::invalid_argument>([&](){
+            auto other = last.result().then([](Int64 x) { return x; });
+        });
+
+        // move-only value
+        auto unique = ThreadPool::create<std::unique_ptr<Int64>()>([]() {
+            return std::make_unique<Int64>(1234);
+        });
+
+        auto deref = unique.result().then([](std::unique_ptr<Int64> ptr) -> Int64 {
+            return *ptr;
+        });
+
+        unique.schedule();
+        deref.join();
+        Test::assert_that(deref.result().get().value() == 1234);
+    });
+
+    Test::test("Future: then outlives its task", []()
+    {
+        auto invoked = std::make_shared<std::atomic<bool>>(false);
+
+        auto task = ThreadPool::create<Int64()>([]() -> Int64 {
+            return 4;
+        });
+
+        {
+            auto dropped = task.result().then([invoked](Int64) {
+                invoked->store(true);
+            });
+        }
+
+        task.schedule();
+        task.join();
+
+        for (uint64_t i = 0; i < 1000 and not invoked->load(); ++i)
+            jl_eval_string("sleep(0.001)");
+
+        Test::assert_that(invoked->load());
+    });
+
+    Test::test("Future: then after failed task", []()
+    {
+        auto task = ThreadPool::create<Int64()>([]() -> Int64 {
+            throw std::runtime_error("abc");
+        });
+
+        auto next = task.result().then([](Int64 x) -> Int64 {
+            return x;
+        });
+
+        task.schedule();
+
+        Test::assert_that_throws<JuliaException>([&](){
+            next.join();
+        });
+
+        Test::assert_that(task.is_failed());
+        Test::assert_that(not task.result().wait().has_value());
+        Test::assert_that(not next.result().get().has_value());
+    });
+
+    Test::test("Future: when_all", []()
+    {
+        auto a = ThreadPool::create<Int64()>([]() -> Int64 {
+            return 1;
+        });
+
+        auto b = ThreadPool::create<std::string()>([]() -> std::string {
+            return "abc";
+        });
+
+        auto all = when_all(a.result(), b.result());
+
+        b.schedule();
+        a.schedule();
+        all.join();
+
+        auto result = all.result().get().value();
+        Test::assert_that(std::get<0>(result) == 1);
+        Test::assert_that(std::get<1>(result) == "abc");
+
+        auto failing = ThreadPool::create<Int64()>([]() -> Int64 {
+            throw std::runtime_error("abc");
+        });
+
+        auto c = ThreadPool::create<Int64()>([]() -> Int64 {
+            return 3;
+        });
+
+        auto partial = when_all(failing.result(), c.result());
+
+        failing.schedule();
+        c.schedule();
+
+        Test::assert_that_throws<JuliaException>([&](){
+            partial.join();
+        });
+        Test::assert_that(c.result().get().value() == 3);
+    });
+
+    Test::test("Future: when_any", []()
+    {
+        auto a = ThreadPool::create<Int64()>([]() -> Int64 {
+            return 1;
+        });
+
+        auto b = ThreadPool::create<Int64()>([]() -> Int64 {
+            return 2;
+        });
+
+        auto any = when_any(a.result(), b.result());
+
+        b.schedule();
+        any.join();
+
+        auto result = any.result().get().value();
+        Test::assert_that(result.first == 1);
+        Test::assert_that(result.second == 2);
+
+        // futures finishing later keep their value
+        a.schedule();
+        a.join();
+        Test::assert_that(a.result().get().value() == 1);
+    });
+
+    Test::test("Function: call", [](){
+
+        Main.safe_eval("f_function_test(x::Int64, y::String) = string(x) * y");
+        auto f = jluna::Function<std::string(Int64, std::string)>(Main["f_function_test"]);
+        Test::assert_that(f(12, "34") == "1234");
+
+        Main.safe_eval("f_function_test_void(x) = nothing");
+        jluna::Function<void(std::vector<Int64>)> f_void = Main["f_function_test_void"];
+        f_void({1, 2, 3});
+
+        jluna::Function<Float64(Float64)> f_sqrt = Base["sqrt"];
+        auto copy = f_sqrt;
+        Test::assert_that(copy(4) == 2);
+
+        Test::assert_that_throws<JuliaException>([&](){
+            f_sqrt(-1);
+        });
+    });
+
+    Test::test("Function: compiled call", [](){
+
+        Main.safe_eval(R"(
+            f_compiled_test(x::Int32, y::Float64, z::Bool) = z ? x * y : 0
+            f_compiled_test_void(x::Ptr{Cvoid}) = nothing
+        )");
+
+        // ccall-compatible signatures are compiled
+        jluna::Function<Float64(Int32, Float64, bool)> f = Main["f_compiled_test"];
+        Test::assert_that(f(2, 1.5, true) == 3);
+        Test::assert_that(f(2, 1.5, false) == 0);
+
+        jluna::Function<void(void*)> f_void = Main["f_compiled_test_void"];
+        f_void(nullptr);
+
+        // result is converted to the declared type
+        jluna::Function<Int64(Float64)> f_round = Base["round"];
+        Test::assert_that(f_round(1.6) == 2);
+
+        // no matching method
+        jluna::Function<Float64(Float64, Float64, bool)> f_mismatch = Main["f_compiled_test"];
+        Test::assert_that_throws<JuliaException>([&](){
+            f_mismatch(2, 1.5, true);
+        });
+
+        // compiled closures are released along with the last handle
+        auto n_compiled = [](){
+            return jl_unbox_int64(jl_eval_string("return Int64(length(jluna._compiled_functions))"));
+        };
+
+        auto before = n_compiled();
+        {
+            jluna::Function<Int64(Int64)> f_closure(jl_eval_string("let offset = 10; x::Int64 -> x + offset end"));
+            auto f_copy = f_closure;
+            Test::assert_that(f_closure(1) == 11 and f_copy(2) == 12);
+            Test::assert_that(n_compiled() <= before + 1);
+        }
+        Test::assert_that(n_compiled() == before);
+    });
+
+    Test::test("Array: raw iterators", [](){
+
+        static_assert(std::contiguous_iterator<decltype(std::declval<Array<Float64, 1>>().raw_begin())>);
+
+        Array<Float64, 2> array = Main.safe_eval("return Float64[1 2 3; 4 5 6]");
+        Test::assert_that(std::distance(array.raw_begin(), array.raw_end()) == 6);
+        Test::assert_that(std::accumulate(array.raw_begin(), array.raw_end(), 0.0) == 21);
+
+        // column-major
+        Test::assert_that(*(array.raw_begin() + 1) == 4);
+
+        std::sort(array.raw_begin(), array.raw_end(), std::greater<>());
+        Test::assert_that(array.at<Float64>(0, 0) == 6);
+
+        const auto& as_const = array;
+        Test::assert_that(std::find(as_const.raw_begin(), as_const.raw_end(), 3) - as_const.raw_begin() == 3);
+
+        auto empty = Vector<Int32>();
+        Test::assert_that(empty.raw_begin() == empty.raw_end());
+    });
+
+    Test::test("Array: metadata caching", [](){
+
+        Array<Int32, 2> array = Main.safe_eval("return Int32[1 2 3; 4 5 6]");
+        array.set_metadata_caching_enabled(true);
+        Test::assert_that(array.get_metadata_caching_enabled());
+
+        Test::assert_that(array.size(0) == 2 and array.size(1) == 3);
+        Test::assert_that(array.get_n_elements() == 6);
+        Test::assert_that(static_cast<Int32>(array.at(1, 2)) == 6);
+
+        const auto& as_const = array;
+        Test::assert_that(as_const.at(1, 0) == 4);
+        Test::assert_that_throws<std::out_of_range>([&](){
+            as_const.at(2, 0);
+        });
+
+        // reassigning invalidates cache
+        array = Main.safe_eval("return Int32[1 2; 3 4; 5 6; 7 8]");
+        Test::assert_that(array.size(0) == 4 and array.size(1) == 2);
+        Test::assert_that(as_const.at(3, 1) == 8);
+
+        Vector<Int64> vector = Main.safe_eval("return Int64[1, 2, 3]");
+        vector.set_metadata_caching_enabled(true);
+        Test::assert_that(vector.get_n_elements() == 3);
+
+        // resizing through jluna invalidates cache
+        for (Int64 i = 4; i <= 1000; ++i)
+            vector.push_back(i);
+
+        Test::assert_that(vector.get_n_elements() == 1000);
+        Test::assert_that(static_cast<const Vector<Int64>&>(vector).at(999) == 1000);
+
+        vector.erase(0);
+        vector.push_front(-1);
+        Test::assert_that(static_cast<Int64>(vector.front()) == -1 and vector.size(0) == 1000);
+
+        // resizing Julia-side requires manual update
+        safe_call(unsafe::get_function(jl_base_module, "push!"_sym), vector.operator unsafe::Value*(), box<Int64>(1001));
+        vector.update_metadata();
+        Test::assert_that(vector.get_n_elements() == 1001);
+    });
+
+    Test::test("Array: as_span", [](){
+
+        Array<Int32, 2> array = Main.safe_eval("return Int32[1 2 3; 4 5 6]");
+
+        std::span<Int32> span = array.as_span();
+        Test::assert_that(span.size() == 6);
+        Test::assert_that(span[1] == 4);
+
+        span[0] = -1;
+        Test::assert_that(static_cast<Int32>(array.at(0, 0)) == -1);
+
+        auto mdspan = array.as_mdspan();
+        Test::assert_that(mdspan.size(0) == 2 and mdspan.size(1) == 3);
+        Test::assert_that(mdspan.stride(0) == 1 and mdspan.stride(1) == 2);
+        Test::assert_that(mdspan.at(1, 2) == 6);
+
+        Test::assert_that(mdspan.column(2).as_span().size() == 2);
+        Test::assert_that_throws<std::invalid_argument>([&](){
+            mdspan.row(0).as_span();
+        });
+    });
+
+    Test::test("ArrayView: from array", [](){
+
+        Array<Int64, 2> array = Main.safe_eval("return reshape(collect(Int64(1):12), 3, 4)");
+        auto view = ArrayView<Int64, 2>(array);
+
+        Test::assert_that(view.size(0) == 3 and view.size(1) == 4);
+        Test::assert_that(view.is_contiguous());
+        Test::assert_that(view.at(2, 1) == 6);
+
+        // writes go to the Julia-side memory
+        view.at(0, 0) = 100;
+        Test::assert_that(array.at<Int64>(0) == 100);
+
+        Test::assert_that_throws<std::out_of_range>([&](){
+            view.at(3, 0);
+        });
+
+        Test::assert_that_throws<std::out_of_range>([&](){
+            view.at(-1, 0);
+        });
+
+        // value type only changes if the variable is reassigned Julia-side after the array was constructed
+        Main.safe_eval("array_view_rebound = Int64[1 2; 3 4]");
+        auto rebound = Main["array_view_rebound"].as<Array<Int64, 2>>();
+        Main.safe_eval("array_view_rebound = Float64[1 2; 3 4]");
+        rebound.update();
+
+        Test::assert_that_throws<JuliaException>([&](){
+            auto view = ArrayView<Int64, 2>(rebound);
+        });
+    });
+
+    Test::test("ArrayView: derived views share owner", [](){
+
+        auto column = [](){
+            Array<Int64, 2> array = Main.safe_eval("return reshape(collect(Int64(1):12), 3, 4)");
+            auto view = ArrayView<Int64, 2>(array);
+            return view.column(3).range(0, 1, 3);
+        }();
+
+        // only the derived view keeps the memory alive at this point
+        collect_garbage();
+        Test::assert_that(column.get_n_elements() == 2);
+        Test::assert_that(column.at(0) == 11 and column.at(1) == 12);
+
+        auto copy = column;
+        auto moved = std::move(column);
+        collect_garbage();
+        Test::assert_that(copy.at(1) == 12 and moved.at(0) == 11);
+    });
+
+    Test::test("ArrayView: slicing", [](){
+
+        Array<Float64, 2> array = Main.safe_eval("return Float64[1 2 3; 4 5 6]");
+        auto view = ArrayView<Float64, 2>(array);
+
+        auto column = view.column(1);
+        Test::assert_that(column.get_n_elements() == 2 and column.is_contiguous());
+        Test::assert_that(column.at(0) == 2 and column.at(1) == 5);
+
+        auto row = view.row(1);
+        Test::assert_that(row.get_n_elements() == 3 and not row.is_contiguous());
+        Test::assert_that(row.at(0) == 4 and row.at(2) == 6);
+
+        auto columns = view.range(1, 1, 3);
+        Test::assert_that(columns.size(1) == 2 and columns.at(0, 0) == 2);
+
+        std::vector<Float64> elements;
+        for (auto x : view.range(0, 1, 2))
+            elements.push_back(x);
+
+        Test::assert_that(elements == std::vector<Float64>{4, 5, 6});
+
+        auto reshaped = view.reshape(3, 2);
+        Test::assert_that(reshaped.at(2, 1) == 6);
+
+        Test::assert_that_throws<std::invalid_argument>([&](){
+            row.reshape(3);
+        });
+
+        Test::assert_that_throws<std::invalid_argument>([&](){
+            view.reshape(4, 2);
+        });
+    });
+
+    Test::test("ArrayView: from SubArray", [](){
+
+        Main.safe_eval("array_view_test = collect(reshape(Int32(1):Int32(20), 4, 5))");
+        auto sub = Main.safe_eval("return view(array_view_test, 2:3, 1:2:5)");
+
+        auto view = ArrayView<Int32, 2>(sub);
+        Test::assert_that(view.size(0) == 2 and view.size(1) == 3);
+        Test::assert_that(view.at(0, 0) == 2 and view.at(1, 2) == 19);
+
+        view.at(1, 2) = -1;
+        Test::assert_that((Int32) Main.safe_eval("return array_view_test[3, 5]") == -1);
+
+        Test::assert_that_throws<JuliaException>([](){
+            ArrayView<Int64, 2>(Main.safe_eval("return view(array_view_test, 2:3, 1:2:5)"));
+        });
+
+        Test::assert_that_throws<JuliaException>([](){
+            ArrayView<Int32, 1>(Main.safe_eval("return [1, 2, 3] .== 1"));
+        });
+    });
+
+    Test::test("parallel_for", []()
+    {
+        std::vector<std::atomic<uint64_t>> visited(10007);
+        parallel_for(visited.size(), [&](uint64_t i) {
+            visited.at(i) += 1;
+        });
+
+        bool all_once = true;
+        for (auto& v : visited)
+            all_once = all_once and v == 1;
+
+        Test::assert_that(all_once);
+
+        Array<Float64, 2> array = Main.safe_eval("return reshape(collect(Float64, 1:10000), 100, 100)");
+        parallel_for(array, [](Float64& x) {
+            x *= 2;
+        }, 7);
+
+        Test::assert_that(array.at<Float64>(0) == 2 and array.at<Float64>(9999) == 20000);
+
+        Test::assert_that_throws<JuliaException>([](){
+            Array<Float64, 1> wrong_type = Main.safe_eval("return Int64[1, 2, 3]");
+        });
+
+        // value type only changes if the variable is reassigned Julia-side after the array was constructed
+        Main.safe_eval("parallel_for_rebound = Float64[1, 2, 3]");
+        auto rebound = Main["parallel_for_rebound"].as<Array<Float64, 1>>();
+        Main.safe_eval("parallel_for_rebound = Int64[1, 2, 3]");
+        rebound.update();
+
+        Test::assert_that_throws<std::invalid_argument>([&](){
+            parallel_for(rebound, [](Float64&) {});
+        });
+    });
+
+    Test::test("parallel_transform", []()
+    {
+        Vector<Int32> in = Main.safe_eval("return collect(Int32, 1:10000)");
+        Vector<Float64> out = Main.safe_eval("return zeros(Float64, 10000)");
+
+        parallel_transform(in, out, [](Int32 x) -> Float64 {
+            return x * 0.5;
+        });
+
+        for (uint64_t i : {0, 1, 5000, 9999})
+            Test::assert_that(out.at<Float64>(i) == (i + 1) * 0.5);
+    });
+
+    Test::test("parallel_reduce", []()
+    {
+        Vector<Int64> array = Main.safe_eval("return collect(Int64, 1:100000)");
+
+        auto sum = parallel_reduce(array, Int64(0), [](Int64 a, Int64 b) {
+            return a + b;
+        });
+        Test::assert_that(sum == 5000050000);
+
+        auto max = parallel_reduce(array, Int64(-1), [](Int64 a, Int64 b) {
+            return std::max(a, b);
+        }, 3);
+        Test::assert_that(max == 100000);
+
+        Vector<Int64> empty = Main.safe_eval("return Int64[]");
+        Test::assert_that(parallel_reduce(empty, Int64(123), std::plus<Int64>()) == 123);
+    });
+
+    Test::test("simd: element-wise", []()
+    {
+        Main.safe_eval("simd_a = rand(Float64, 1003); simd_b = rand(Float64, 1003); simd_c = rand(Float64, 1003)");
+        Vector<Float64> a = Main["simd_a"];
+        Vector<Float64> b = Main["simd_b"];
+        Vector<Float64> c = Main["simd_c"];
+        Vector<Float64> out = Main.safe_eval("return similar(simd_a)");
+
+        simd::add(a, b, out);
+        Test::assert_that(Main.safe_eval("return simd_a .+ simd_b").operator std::vector<Float64>() == out.operator std::vector<Float64>());
+
+        simd::fma(a, b, c, out);
+        Test::assert_that(Main.safe_eval("return fma.(simd_a, simd_b, simd_c)").operator std::vector<Float64>() == out.operator std::vector<Float64>());
+
+        // in-place
+        Main.safe_eval("simd_expected = simd_a .* simd_b");
+        simd::multiply(a, b, a);
+        Test::assert_that(Main.safe_eval("return simd_a == simd_expected").operator bool());
+
+        // overflow wraps
+        Array<Int8, 2> x = Main.safe_eval("return Int8[100 -100; 1 2]");
+        Array<Int8, 2> y = Main.safe_eval("return Int8[100 -100; 3 1]");
+        Array<Int8, 2> z = Main.safe_eval("return zeros(Int8, 2, 2)");
+        simd::add(x, y, z);
+        Test::assert_that(static_cast<Int8>(z.at(0, 0)) == -56 and static_cast<Int8>(z.at(0, 1)) == 56);
+
+        Array<bool, 2> mask = Main.safe_eval("return zeros(Bool, 2, 2)");
+        simd::less(x, y, mask);
+        Test::assert_that(static_cast<bool>(mask.at(1, 0)) and not static_cast<bool>(mask.at(1, 1)) and not static_cast<bool>(mask.at(0, 0)));
+
+        simd::equal(x, y, mask);
+        Test::assert_that(static_cast<bool>(mask.at(0, 0)) and static_cast<bool>(mask.at(0, 1)) and not static_cast<bool>(mask.at(1, 0)));
+
+        Vector<Float64> too_short = Main.safe_eval("return rand(Float64, 3)");
+        Test::assert_that_throws<std::out_of_range>([&](){
+            simd::add(a, too_short, out);
+        });
+    });
+
+    Test::test("simd: reductions", []()
+    {
+        Vector<Int32> ints = Main.safe_eval("return collect(Int32, 1:100000)");
+        Test::assert_that(simd::sum(ints) == 5000050000);
+        Test::assert_that(simd::minimum(ints) == 1);
+        Test::assert_that(simd::maximum(ints) == 100000);
+
+        Main.safe_eval("simd_d = rand(Float64, 12345) .- 0.5");
+        Vector<Float64> floats = Main["simd_d"];
+        Test::assert_that(std::abs(simd::sum(floats) - Main.safe_eval("return sum(simd_d)").operator Float64()) < 1e-9);
+        Test::assert_that(std::abs(simd::dot(floats, floats) - Main.safe_eval("return sum(simd_d .* simd_d)").operator Float64()) < 1e-9);
+        Test::assert_that(simd::minimum(floats) == Main.safe_eval("return minimum(simd_d)").operator Float64());
+        Test::assert_that(simd::maximum(floats) == Main.safe_eval("return maximum(simd_d)").operator Float64());
+
+        Main.safe_eval("simd_d[1000] = NaN");
+        Test::assert_that(std::isnan(simd::minimum(floats)));
+
+        Vector<Float64> empty = Main.safe_eval("return Float64[]");
+        Test::assert_that(simd::sum(empty) == 0);
+        Test::assert_that_throws<std::invalid_argument>([&](){
+            simd::maximum(empty);
+        });
+    });
+
+    Test::test("simd: expressions", []()
+    {
+        Main.safe_eval("simd_a = rand(Float64, 1003); simd_b = rand(Float64, 1003); simd_c = rand(Float64, 1003)");
+        Vector<Float64> a = Main["simd_a"];
+        Vector<Float64> b = Main["simd_b"];
+        Vector<Float64> c = Main["simd_c"];
+        Vector<Float64> out = Main.safe_eval("return similar(simd_a)");
+
+        simd::assign(out, simd::expr(a) * b + c - a);
+        Test::assert_that(Main.safe_eval("return simd_a .* simd_b .+ simd_c .- simd_a").operator std::vector<Float64>() == out.operator std::vector<Float64>());
+
+        simd::assign(out, simd::fma(a, b, simd::expr(c) * c));
+        Test::assert_that(Main.safe_eval("return fma.(simd_a, simd_b, simd_c .* simd_c)").operator std::vector<Float64>() == out.operator std::vector<Float64>());
+
+        // operands may alias the output
+        Main.safe_eval("simd_expected = (simd_a .+ simd_b) .* simd_a");
+        simd::assign(a, (simd::expr(a) + b) * a);
+        Test::assert_that(Main.safe_eval("return simd_a == simd_expected").operator bool());
+
+        Vector<bool> mask = Main.safe_eval("return Vector{Bool}(undef, 1003)");
+        simd::assign(mask, simd::less(simd::expr(b) * b, c));
+        Test::assert_that(Main.safe_eval("return simd_b .* simd_b .< simd_c").operator std::vector<bool>() == mask.operator std::vector<bool>());
+
+        Test::assert_that(std::abs(simd::sum(simd::expr(b) * c) - Main.safe_eval("return sum(simd_b .* simd_c)").operator Float64()) < 1e-9);
+        Test::assert_that(std::abs(simd::dot(simd::expr(b) + c, b) - Main.safe_eval("return sum((simd_b .+ simd_c) .* simd_b)").operator Float64()) < 1e-9);
+        Test::assert_that(simd::minimum(simd::expr(b) - c) == Main.safe_eval("return minimum(simd_b .- simd_c)").operator Float64());
+        Test::assert_that(simd::maximum(simd::expr(b) - c) == Main.safe_eval("return maximum(simd_b .- simd_c)").operator Float64());
+
+        Vector<Int64> ints = Main.safe_eval("return collect(Int64, 1:10000)");
+        Test::assert_that(simd::sum(simd::expr(ints) * ints) == 333383335000);
+
+        Vector<Float64> too_short = Main.safe_eval("return rand(Float64, 3)");
+        Test::assert_that_throws<std::out_of_range>([&](){
+            auto expression = simd::expr(a) + too_short;
+        });
+
+        Test::assert_that_throws<std::out_of_range>([&](){
+            simd::assign(too_short, simd::expr(a) + b);
+        });
+    });
+
+    Test::test("safe_call: concurrent", []()
+    {
+        std::vector<Task<Int64>> tasks;
+        for (Int64 i = 0; i < 4; ++i)
+        {
+            tasks.push_back(ThreadPool::create<Int64()>([i]() -> Int64 {
+
+                static auto* plus = unsafe::get_function(jl_base_module, "+"_sym);
+
+                Int64 sum = 0;
+                for (Int64 j = 0; j < 500; ++j)
+                    sum += unbox<Int64>(safe_call(plus, box<Int64>(i), box<Int64>(j)));
+
+                return sum;
+            }));
+        }
+
+        for (auto& task : tasks)
+            task.schedule();
+
+        for (Int64 i = 0; i < 4; ++i)
+        {
+            tasks.at(i).join();
+            Test::assert_that(tasks.at(i).result().get().value() == 500 * i + 124750);
+        }
+    });
+
     return Test::conclude() ? 0 : 1;
 }
 
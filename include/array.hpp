@@ -9,11 +9,17 @@
 #include <include/proxy.hpp>
 #include <include/generator_expression.hpp>
 
+#include <array>
+#include <span>
+
 namespace jluna
 {
     template<is_boxable T>
     class Vector;
 
+    template<is_isbits_compatible T, uint64_t Rank>
+    class ArrayView;
+
     /// @brief wrapper for julia-side Array{Value_t, Rank}
     /// @tparam Value_t: boxable value ype
     /// @tparam Rank: rank of the array
@@ -121,6 +127,45 @@ namespace jluna
             /// @returns const iterator
             auto end() const;
 
+            /// @brief get pointer to first element, only available if the value type has the same memory layout as the Julia-side element type
+            /// @returns pointer into the Julia-side data, satisfies std::contiguous_iterator
+            /// @note the pointer is invalidated if the array is resized
+            template<typename T = Value_t, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, Value_t>, bool> = true>
+            T* raw_begin();
+
+            /// @brief get pointer to first element, only available if the value type has the same memory layout as the Julia-side element type
+            /// @returns const pointer into the Julia-side data, satisfies std::contiguous_iterator
+            /// @note the pointer is invalidated if the array is resized
+            template<typename T = Value_t, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, Value_t>, bool> = true>
+            const T* raw_begin() const;
+
+            /// @brief get pointer to past-the-end element, only available if the value type has the same memory layout as the Julia-side element type
+            /// @returns pointer into the Julia-side data, satisfies std::contiguous_iterator
+            template<typename T = Value_t, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, Value_t>, bool> = true>
+            T* raw_end();
+
+            /// @brief get pointer to past-the-end element, only available if the value type has the same memory layout as the Julia-side element type
+            /// @returns const pointer into the Julia-side data, satisfies std::contiguous_iterator
+            template<typename T = Value_t, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, Value_t>, bool> = true>
+            const T* raw_end() const;
+
+            /// @brief expose data as a span, only available if the value type has the same memory layout as the Julia-side element type
+            /// @returns span over all elements, in column-major order
+            /// @note the span does not keep the array safe from the garbage collector, it is only valid while this proxy exists and the array is not resized. Use as_mdspan for a view that roots the array itself
+            template<typename T = Value_t, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, Value_t>, bool> = true>
+            std::span<T> as_span();
+
+            /// @brief expose data as a span, only available if the value type has the same memory layout as the Julia-side element type
+            /// @returns span over all elements, in column-major order
+            /// @note the span does not keep the array safe from the garbage collector, it is only valid while this proxy exists and the array is not resized. Use as_mdspan for a view that roots the array itself
+            template<typename T = Value_t, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, Value_t>, bool> = true>
+            std::span<const T> as_span() const;
+
+            /// @brief expose data, dimensions and column-major strides as a multi-dimensional view, only available if the value type has the same memory layout as the Julia-side element type
+            /// @returns ArrayView of the same rank, keeps the array safe from the garbage collector for its lifetime
+            template<typename T = Value_t, std::enable_if_t<is_isbits_compatible<T> and std::is_same_v<T, Value_t>, bool> = true>
+            ArrayView<T, Rank> as_mdspan() const;
+
             /// @brief get first element, equivalent to operator[](0)
             /// @returns assignable iterator
             auto front();
@@ -147,6 +192,18 @@ namespace jluna
             /// @param size: target size
             void reserve(uint64_t);
 
+            /// @brief enable caching of the data pointer and dimensions. If enabled, size queries and bounds-checked indexing do not call into Julia, indexing of isbits-compatible values becomes pointer arithmetic
+            /// @param enabled: true to enable, false to disable
+            /// @note the cache is invalidated when the array is modified through jluna, such as by Vector::push_back, reserve or Proxy::operator=. If the array is resized Julia-side, the user is responsible for calling update_metadata
+            void set_metadata_caching_enabled(bool enabled);
+
+            /// @brief is caching of the data pointer and dimensions enabled
+            /// @returns true if enabled, false otherwise
+            bool get_metadata_caching_enabled() const;
+
+            /// @brief force re-querying the data pointer and dimensions from Julia the next time they are accessed
+            void update_metadata();
+
             /// @brief cast to unsafe::Value*, implicit
             using Proxy::operator unsafe::Value*;
 
@@ -198,6 +255,22 @@ namespace jluna
             void throw_if_index_out_of_range(int index, uint64_t dimension) const;
             uint64_t get_dimension(uint64_t) const;
 
+            // data pointer and dimensions, valid while generation matches the generation of _content
+            struct Metadata
+            {
+                bool is_enabled = false;
+                bool is_valid = false;
+                uint64_t generation = 0;
+
+                unsafe::Array* array = nullptr;
+                void* data = nullptr;
+                uint64_t length = 0;
+                std::array<uint64_t, Rank> size = {};
+            };
+
+            const Metadata& get_metadata() const;
+            mutable Metadata _metadata;
+
         public:
             /// @brief non-assignable iterator
             class ConstIterator
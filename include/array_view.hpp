@@ -0,0 +1,200 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#pragma once
+
+#include <include/concepts.hpp>
+#include <include/array.hpp>
+
+#include <array>
+#include <iterator>
+#include <memory>
+#include <span>
+
+namespace jluna
+{
+    /// @brief view of the memory of a Julia-side array or strided SubArray, accessed directly through a pointer. Slicing, sub-ranges, reshaping and copying a view do not call into Julia
+    /// @tparam Value_t: value type, has to have the same memory layout as the Julia-side element type
+    /// @tparam Rank: number of dimensions
+    template<is_isbits_compatible Value_t, uint64_t Rank>
+    class ArrayView
+    {
+        static_assert(Rank >= 1, "In jluna::ArrayView: rank has to be at least 1");
+
+        template<is_isbits_compatible, uint64_t>
+        friend class ArrayView;
+
+        public:
+            class Iterator;
+
+            /// @brief value type
+            using value_type = Value_t;
+
+            /// @brief number of dimensions
+            static constexpr uint64_t rank = Rank;
+
+            /// @brief construct view of the entire array
+            /// @param array: array, its value type has to match the Julia-side element type
+            /// @exceptions throws JuliaException if the element type does not match
+            ArrayView(const Array<Value_t, Rank>& array);
+
+            /// @brief construct from Julia-side strided array, such as a SubArray, Array or ReshapedArray
+            /// @param array: Julia-side array, its element type has to be Value_t and it has to have Rank-many dimensions
+            /// @exceptions throws JuliaException if array is not strided, or element type or rank do not match
+            explicit ArrayView(unsafe::Value* array);
+
+            /// @brief construct from proxy managing a Julia-side strided array, the proxies value is resolved once
+            /// @param proxy: proxy
+            /// @exceptions throws JuliaException if the value is not strided, or element type or rank do not match
+            explicit ArrayView(Proxy proxy);
+
+            /// @brief construct from raw memory
+            /// @param data: pointer to element at index (0, 0, ...)
+            /// @param size: number of elements along each dimension
+            /// @param strides: distance between two consecutive elements along each dimension, in number of elements
+            /// @param owner: [optional] Julia-side object owning the memory, will be kept safe from the garbage collector for the lifetime of the view. If nullptr, the user is responsible for data staying valid
+            ArrayView(Value_t* data, std::array<uint64_t, Rank> size, std::array<int64_t, Rank> strides, unsafe::Value* owner = nullptr);
+
+            /// @brief access element, bounds-checked
+            /// @param index: Rank-many 0-based indices
+            /// @returns reference to element inside the Julia-side memory
+            template<typename... Index_t, std::enable_if_t<sizeof...(Index_t) == Rank and (std::is_integral_v<Index_t> and ...), bool> = true>
+            Value_t& at(Index_t... index) const;
+
+            /// @brief get number of elements along a dimension
+            /// @param dimension: 0-based
+            /// @returns size
+            uint64_t size(uint64_t dimension) const;
+
+            /// @brief get distance between two consecutive elements along a dimension
+            /// @param dimension: 0-based
+            /// @returns stride, in number of elements
+            int64_t stride(uint64_t dimension) const;
+
+            /// @brief get total number of elements
+            /// @returns product of all sizes
+            uint64_t get_n_elements() const;
+
+            /// @brief is empty
+            /// @returns true if size is 0 along any dimension
+            bool empty() const;
+
+            /// @brief are elements stored in column-major order without gaps
+            /// @returns true if contiguous, false otherwise
+            bool is_contiguous() const;
+
+            /// @brief access raw data
+            /// @returns pointer to element at index (0, 0, ...)
+            Value_t* data() const;
+
+            /// @brief expose contiguous view as a span
+            /// @returns span over all elements, in column-major order
+            /// @note the span does not keep the memory safe from the garbage collector, it is only valid while this view exists
+            std::span<Value_t> as_span() const;
+
+            /// @brief restrict view to a range along one dimension
+            /// @param dimension: 0-based
+            /// @param first: first index of the range, 0-based
+            /// @param last: past-the-end index of the range
+            /// @returns view of the same rank
+            ArrayView<Value_t, Rank> range(uint64_t dimension, uint64_t first, uint64_t last) const;
+
+            /// @brief fix the index along one dimension
+            /// @param dimension: 0-based
+            /// @param index: 0-based
+            /// @returns view with one dimension less
+            template<uint64_t R = Rank, std::enable_if_t<(R >= 2), bool> = true>
+            ArrayView<Value_t, R - 1> slice(uint64_t dimension, uint64_t index) const;
+
+            /// @brief get column of a matrix
+            /// @param index: 0-based
+            /// @returns view of rank 1, contiguous
+            template<uint64_t R = Rank, std::enable_if_t<R == 2, bool> = true>
+            ArrayView<Value_t, 1> column(uint64_t index) const;
+
+            /// @brief get row of a matrix
+            /// @param index: 0-based
+            /// @returns view of rank 1, strided
+            template<uint64_t R = Rank, std::enable_if_t<R == 2, bool> = true>
+            ArrayView<Value_t, 1> row(uint64_t index) const;
+
+            /// @brief reinterpret contiguous view with different dimensions, in column-major order
+            /// @param size_per_dimension: new sizes, their product has to equal get_n_elements()
+            /// @returns view of the same memory
+            template<typename... Dims, std::enable_if_t<(sizeof...(Dims) >= 1) and (std::is_integral_v<Dims> and ...), bool> = true>
+            ArrayView<Value_t, sizeof...(Dims)> reshape(Dims... size_per_dimension) const;
+
+            /// @brief get iterator to first element, elements are iterated in column-major order
+            /// @returns iterator
+            Iterator begin() const;
+
+            /// @brief get past-the-end iterator
+            /// @returns iterator
+            Iterator end() const;
+
+            /// @brief forward iterator over all elements of a view, in column-major order
+            class Iterator
+            {
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = Value_t;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = Value_t*;
+                    using reference = Value_t&;
+
+                    /// @brief default ctor
+                    Iterator() = default;
+
+                    /// @brief ctor
+                    /// @param view: view to iterate
+                    /// @param at_end: if true, construct past-the-end iterator
+                    Iterator(const ArrayView* view, bool at_end);
+
+                    /// @brief access element
+                    /// @returns reference to element
+                    Value_t& operator*() const;
+
+                    /// @brief increment
+                    /// @returns reference to self
+                    Iterator& operator++();
+
+                    /// @brief post-fix increment
+                    /// @returns iterator before increment
+                    Iterator operator++(int);
+
+                    /// @brief equality operator
+                    /// @param other: other iterator
+                    /// @returns true if both point to the same element
+                    bool operator==(const Iterator& other) const;
+
+                    /// @brief inequality operator
+                    /// @param other: other iterator
+                    /// @returns not (this == other)
+                    bool operator!=(const Iterator& other) const;
+
+                private:
+                    const ArrayView* _view = nullptr;
+                    std::array<uint64_t, Rank> _index = {};
+                    Value_t* _ptr = nullptr;
+            };
+
+        private:
+            void throw_if_index_out_of_range(uint64_t index, uint64_t dimension) const;
+            void throw_if_dimension_out_of_range(uint64_t dimension) const;
+
+            Value_t* _data = nullptr;
+            std::array<uint64_t, Rank> _size = {};
+            std::array<int64_t, Rank> _strides = {};
+
+            // keeps the memory safe from the garbage collector, shared by all views derived from the same view. The owner is preserved once, when the first view is constructed, and released with the last view
+            using Owner = std::shared_ptr<const uint64_t>;
+            static Owner make_owner(unsafe::Value* owner);
+
+            ArrayView(Owner owner, Value_t* data, std::array<uint64_t, Rank> size, std::array<int64_t, Rank> strides);
+
+            Owner _owner = nullptr;
+    };
+}
+
+#include <.src/array_view.inl>
@@ -10,6 +10,7 @@
 #include <map>
 #include <unordered_map>
 #include <set>
+#include <string_view>
 
 #include <include/julia_wrapper.hpp>
 
@@ -90,12 +91,25 @@ namespace jluna
 
     /// @brief box string to String
     template<is<std::string> T>
+    unsafe::Value* box(const T& value);
+
+    /// @brief box string view to String
+    template<is<std::string_view> T>
     unsafe::Value* box(T value);
 
     /// @brief box c-string to String
     template<is<const char*> T>
     unsafe::Value* box(T value);
 
+    /// @brief box string to String, reusing the Julia-side String if an equal string was boxed by this function before
+    /// @param value: string
+    /// @returns String, for strings of at most 64 bytes the same object is returned for equal strings
+    /// @note interned strings are kept safe from the garbage collector until clear_interned_strings is called. At most 65536 strings are interned, after which strings are boxed normally
+    unsafe::Value* box_interned(std::string_view value);
+
+    /// @brief release all strings interned by box_interned
+    void clear_interned_strings();
+
     /// @brief box std::complex<T> to Complex{T}
     template<typename T,
         typename Value_t = typename T::value_type,
@@ -108,6 +122,13 @@ namespace jluna
         std::enable_if_t<std::is_same_v<T, std::vector<Value_t>>, bool> = true>
     unsafe::Value* box(const T& value);
 
+    /// @brief box std::vector<T> to Vector{T}, taking ownership of its memory
+    /// @note if T is isbits, the Julia-side array uses the memory of the vector directly instead of copying it. The memory is freed once the array is garbage collected
+    template<typename T,
+        typename Value_t = typename T::value_type,
+        std::enable_if_t<std::is_same_v<T, std::vector<Value_t>>, bool> = true>
+    unsafe::Value* box(T&& value);
+
     /// @brief box std::multimap<T, U> to IdDict{T, U}
     template<typename T,
         typename Key_t = typename T::key_type,
@@ -188,6 +209,15 @@ namespace jluna
     static unsafe::Value* box_function_result(Function_t f, Args_t... args);
     template<typename Function_t, typename... Args_t, std::enable_if_t<not std::is_void_v<std::invoke_result_t<Function_t, Args_t...>>, bool> = true>
     static unsafe::Value* box_function_result(Function_t f, Args_t... args);
+
+    namespace detail
+    {
+        /// @brief keep owner alive until array is garbage collected, then call deleter on it
+        /// @param array: Julia-side array using memory managed by owner
+        /// @param owner: C++-side object
+        /// @param deleter: function freeing owner, called from a finalizer
+        void attach_buffer_owner(unsafe::Value* array, void* owner, void(*deleter)(void*));
+    }
 }
 
 #include <.src/box.inl>
\ No newline at end of file
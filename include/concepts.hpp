@@ -186,6 +186,40 @@ namespace jluna
         std::is_same_v<T, std::complex<typename T::value_type>>;
     };
 
+    /// @concept: C++-side memory layout is identical to that of the julia-side isbits type it is boxed as
+    template<typename T>
+    concept is_isbits_compatible =
+        is<T, bool> or
+        is<T, uint8_t> or
+        is<T, uint16_t> or
+        is<T, uint32_t> or
+        is<T, uint64_t> or
+        is<T, int8_t> or
+        is<T, int16_t> or
+        is<T, int32_t> or
+        is<T, int64_t> or
+        is<T, float> or
+        is<T, double> or
+        is<T, std::complex<float>> or
+        is<T, std::complex<double>>;
+
+    /// @concept: can be passed to and returned from a C function by value, without boxing
+    template<typename T>
+    concept is_ccall_compatible =
+        std::is_void_v<T> or
+        is<T, void*> or
+        (is_isbits_compatible<T> and std::is_arithmetic_v<T>);
+
+    /// @concept: arithmetic type with the same memory layout as its Julia-side equivalent, excluding Bool
+    template<typename T>
+    concept is_simd_compatible =
+        is_isbits_compatible<T> and std::is_arithmetic_v<T> and not std::is_same_v<T, bool>;
+
+    /// @concept: value type of std::complex<T> that has the same memory layout as Complex{T}, the standard only guarantees this for floating point types
+    template<typename T>
+    concept is_complex_layout_compatible =
+        std::is_same_v<T, float> or std::is_same_v<T, double>;
+
     /// @concept is std::vector
     template<typename T>
     concept is_vector = requires (T t)
@@ -242,4 +276,8 @@ namespace jluna
 
     template<typename T>
     concept is_usertype = usertype_enabled<T>::value;
+
+    // forward declaration, c.f. include/usertype.hpp
+    template<typename T>
+    class Usertype;
 }
\ No newline at end of file
@@ -44,6 +44,14 @@ namespace jluna
     /// @returns unsafe pointer to Julia-side function object
     template<typename Return_t, typename Arg1_t, typename Arg2_t, typename Arg3_t>
     unsafe::Value* register_function(std::function<Return_t(Arg1_t, Arg2_t, Arg3_t)> f);
+
+    /// @brief make function with signature (T1, T2, ..., Tn) -> Return_t available to julia
+    /// @tparam Return_t: return type of lambda, may be `void`
+    /// @tparam Args_t: argument types, at least 4
+    /// @param function: lambda
+    /// @returns unsafe pointer to Julia-side function object
+    template<typename Return_t, typename... Args_t, std::enable_if_t<(sizeof...(Args_t) > 3), bool> = true>
+    unsafe::Value* register_function(std::function<Return_t(Args_t...)> f);
 }
 
 #include <.src/cppcall.inl>
\ No newline at end of file
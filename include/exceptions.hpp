@@ -12,6 +12,7 @@
 #include <string>
 #include <exception>
 #include <vector>
+#include <memory>
 
 namespace jluna
 {
@@ -27,6 +28,11 @@ namespace jluna
             /// @param stacktrace: string describing the exception and the stacktrace
             JuliaException(jl_value_t* exception, const std::string& stacktrace);
 
+            /// @brief ctor, the description is only formatted once what() is first called
+            /// @param exception: julia-side exception, or instance of jluna.CaughtException holding the exception and its backtrace
+            /// @note exception has to be rooted until the ctor returned, it is preserved by the JuliaException afterwards
+            explicit JuliaException(jl_value_t* exception);
+
             /// @brief get description
             /// @returns c-string
             [[nodiscard]] const char* what() const noexcept final;
@@ -38,6 +44,10 @@ namespace jluna
         protected:
             unsafe::Value* _value = nullptr;
             std::string _message;
+
+        private:
+            struct LazyMessage;
+            std::shared_ptr<LazyMessage> _lazy_message = nullptr;
     };
 
     /// @brief exception thrown when trying to use jluna or julia before initialization
@@ -0,0 +1,75 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#pragma once
+
+#include <include/typedefs.hpp>
+#include <include/box.hpp>
+#include <include/unbox.hpp>
+#include <include/proxy.hpp>
+#include <include/cppcall.hpp>
+
+#include <memory>
+
+namespace jluna
+{
+    template<typename Signature>
+    class Function;
+
+    /// @brief handle to a Julia-side function with fixed C++-side signature. The function is resolved once and preserved for the lifetime of the handle,
+    /// calling it does not go through jluna.invoke or a proxy
+    /// @note if the return type and all argument types are ccall-compatible, the function is compiled for that signature once and called without dynamic dispatch or boxing. The compiled specialization is shared by all handles with the same function and signature and freed along with the last one. If it cannot be compiled, for example because the platform does not support closures as C functions, the function is called dynamically instead
+    template<typename Return_t, typename... Args_t>
+    class Function<Return_t(Args_t...)>
+    {
+        public:
+            /// @brief construct from Julia-side function
+            /// @param function: any callable Julia-side value
+            explicit Function(unsafe::Value* function);
+
+            /// @brief construct from proxy, the proxies value is resolved once
+            /// @param proxy: proxy managing any callable Julia-side value
+            Function(Proxy proxy);
+
+            /// @brief dtor
+            ~Function();
+
+            /// @brief copy ctor
+            /// @param other
+            Function(const Function& other);
+
+            /// @brief move ctor
+            /// @param other: other function, will be unusable after
+            Function(Function&& other) noexcept;
+
+            /// @brief copy assignment
+            /// @param other
+            /// @returns reference to self
+            Function& operator=(const Function& other);
+
+            /// @brief move assignment
+            /// @param other: other function, will be unusable after
+            /// @returns reference to self
+            Function& operator=(Function&& other) noexcept;
+
+            /// @brief call the function, arguments are boxed as their C++-side type, the result is unboxed to Return_t. If the signature is ccall-compatible, the compiled specialization is invoked directly instead
+            /// @param args: arguments
+            /// @returns result
+            /// @exceptions if an exception occurs Julia-side, a JuliaException will be thrown
+            Return_t operator()(Args_t... args) const;
+
+            /// @brief access Julia-side function
+            /// @returns pointer to function
+            operator unsafe::Value*() const;
+
+        private:
+            unsafe::Value* _value = nullptr;
+            uint64_t _value_id = 0;
+
+            // compiled specialization, only used if signature is ccall-compatible. Cached in jluna._compiled_functions, the deleter removes this handles reference
+            std::shared_ptr<void> _compiled = nullptr;
+    };
+}
+
+#include <.src/function.inl>
@@ -1,28 +1,29 @@
 module jluna
 
 """
-`safe_call(::Function, args...) ::Tuple{Any, Bool, Exception, String)`
+`CaughtException`
 
-safely call any function, while forwarding any exception that may have occurred
+exception and backtrace caught during jluna::safe_call, only formatted once the C++-side message is accessed
 """
-function safe_call(f::Function, args...)
+struct CaughtException
+    exception::Any
+    backtrace::Vector
+end
 
-    res::Any = undef
+"""
+`capture_exception(::Any) -> CaughtException`
 
-    backtrace::String = ""
-    exception_occurred::Bool = false
-    exception::Union{Exception, UndefInitializer} = undef
+capture exception and raw backtrace, has to be called while the exception is being handled
+"""
+capture_exception(exception) ::CaughtException = return CaughtException(exception, catch_backtrace())
 
-    try
-        res = f(args...)
-    catch e
-        exception = e
-        backtrace = sprint(Base.showerror, exception, catch_backtrace())
-        exception_occurred = true
-    end
+"""
+`format_exception(::Any) -> String`
 
-    return (res, exception_occurred, exception, backtrace)
-end
+format exception, including its backtrace if it was captured
+"""
+format_exception(caught::CaughtException) ::String = return sprint(Base.showerror, caught.exception, caught.backtrace)
+format_exception(exception::Any) ::String = return sprint(Base.showerror, exception)
 
 """
 `dot(::Array, field::Symbol) -> Any`
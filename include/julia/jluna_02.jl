@@ -131,6 +131,26 @@ function get_value_type_of_array(_::Array{T}) ::Type where T
     return T
 end
 
+"""
+`get_strided_layout(::StridedArray, ::Type, ::Integer) -> Vector{Int64}`
+
+get memory layout of a strided array as [pointer, size..., strides...], strides are in number of elements
+"""
+function get_strided_layout(x::StridedArray, value_type::Type, rank::Integer) ::Vector{Int64}
+
+    if eltype(x) != value_type
+        throw(ArgumentError("value type of array " * string(eltype(x)) * " does not match view value type " * string(value_type)))
+    end
+
+    if ndims(x) != rank
+        throw(ArgumentError("array has " * string(ndims(x)) * " dimensions, but view has rank " * string(rank)))
+    end
+
+    return Int64[reinterpret(Int64, UInt64(pointer(x))), size(x)..., strides(x)...]
+end
+
+get_strided_layout(x::Any, value_type::Type, rank::Integer) = throw(ArgumentError("object of type " * string(typeof(x)) * " is not a strided array"))
+
 """
 `new_vector(::Integer, ::T) -> Vector{T}`
 
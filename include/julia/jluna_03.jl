@@ -17,6 +17,95 @@ function invoke(x::Any, args...) ::Any
     return x(args...)
 end
 
+"""
+`TypedCallWrapper{F, Return_t}`
+
+callable that converts the result of a function to a fixed type, specialized on the type of the function
+"""
+struct TypedCallWrapper{F, Return_t}
+    _f::F
+end
+
+(wrapper::TypedCallWrapper{F, Return_t})(xs...) where {F, Return_t} = convert(Return_t, wrapper._f(xs...))
+(wrapper::TypedCallWrapper{F, Nothing})(xs...) where F = (wrapper._f(xs...); return nothing)
+
+"""
+`CompiledFunction`
+
+C-callable specialization of a function, shared by all C++-side handles with the same signature
+"""
+mutable struct CompiledFunction
+    _pointer::UInt64
+    _cfunction::Any     # keeps closures alive, nothing for singleton functions
+    _n_references::UInt64
+end
+
+const _compiled_functions = Dict{Tuple{Any, Type, Tuple}, CompiledFunction}()
+const _compiled_functions_lock = ReentrantLock()
+
+"""
+`compiled_function_key(::Any, ::Type, ::Type...) -> Tuple{Any, Type, Tuple}`
+
+create key for compile_function and release_function, computed once per C++-side handle
+"""
+compiled_function_key(f::Any, return_t::Type, arg_ts::Type...) = (f, return_t, arg_ts)
+
+"""
+`compile_function(::Tuple{Any, Type, Tuple}) -> UInt64`
+
+get pointer to a C-callable specialization of a function for fixed argument and return types, cached per signature.
+Each call adds a reference to the cache entry, which has to be removed with release_function. Returns 0 if
+the function cannot be compiled, for example because closures are not supported by @cfunction on this platform
+"""
+function compile_function(key::Tuple{Any, Type, Tuple}) ::UInt64
+
+    f, return_t, arg_ts = key
+    lock(_compiled_functions_lock) do
+
+        if haskey(_compiled_functions, key)
+            compiled = _compiled_functions[key]
+            compiled._n_references += 1
+            return compiled._pointer
+        end
+
+        wrapper = TypedCallWrapper{typeof(f), return_t}(f)
+        compiled = try
+            if Base.issingletontype(typeof(wrapper))
+                # no captured state, does not need a runtime closure
+                pointer = eval(Expr(:macrocall, Symbol("@cfunction"), LineNumberNode(0), wrapper, return_t, Expr(:tuple, arg_ts...)))
+                CompiledFunction(UInt64(pointer), nothing, 1)
+            else
+                cfunction = eval(Expr(:macrocall, Symbol("@cfunction"), LineNumberNode(0), Expr(:$, wrapper), return_t, Expr(:tuple, arg_ts...)))
+                CompiledFunction(UInt64(Base.unsafe_convert(Ptr{Cvoid}, cfunction)), cfunction, 1)
+            end
+        catch
+            return UInt64(0)
+        end
+
+        _compiled_functions[key] = compiled
+        return compiled._pointer
+    end
+end
+
+"""
+`release_function(::Tuple{Any, Type, Tuple}) -> Nothing`
+
+remove one reference added by compile_function, the specialization and the function are freed once no references remain
+"""
+function release_function(key::Tuple{Any, Type, Tuple}) ::Nothing
+
+    lock(_compiled_functions_lock) do
+        if haskey(_compiled_functions, key)
+            compiled = _compiled_functions[key]
+            compiled._n_references -= 1
+            if compiled._n_references == 0
+                delete!(_compiled_functions, key)
+            end
+        end
+    end
+    return nothing
+end
+
 """
 `create_or_assign(::Symbol, ::T) -> T`
 
@@ -57,6 +146,44 @@ function serialize(x::T) ::Vector{U} where {U, T <: AbstractSet{U}}
     return out;
 end
 
+"""
+`serialize_keys_values(::AbstractDict, key_t::Type, value_t::Type) -> Tuple{Vector{key_t}, Vector{value_t}}`
+
+transform dict into two parallel arrays of keys and values, converted to the given types
+"""
+function serialize_keys_values(x::AbstractDict, key_t::Type, value_t::Type) ::Tuple{Vector{key_t}, Vector{value_t}}
+
+    keys_out = Vector{key_t}(undef, length(x))
+    values_out = Vector{value_t}(undef, length(x))
+
+    i = 1
+    for (key, value) in x
+        @inbounds keys_out[i] = key
+        @inbounds values_out[i] = value
+        i += 1
+    end
+
+    return (keys_out, values_out)
+end
+
+"""
+`serialize_values(::AbstractSet, value_t::Type) -> Vector{value_t}`
+
+transform set into array, converted to the given type
+"""
+function serialize_values(x::AbstractSet, value_t::Type) ::Vector{value_t}
+
+    out = Vector{value_t}(undef, length(x))
+
+    i = 1
+    for e in x
+        @inbounds out[i] = e
+        i += 1
+    end
+
+    return out
+end
+
 """
 `new_dict(key_t::Type, value_t::Type, ::Integer) -> Dict{key_t, value_t}`
 
@@ -70,6 +197,23 @@ function new_dict(key_t::Type, value_t::Type, sizehint_maybe::Integer = 0)
 end
 
 
+"""
+`new_dict(keys::AbstractVector{K}, values::AbstractVector{V}) -> Dict{K, V}`
+
+create new dict from two parallel arrays of keys and values
+"""
+function new_dict(keys::AbstractVector{K}, values::AbstractVector{V}) ::Dict{K, V} where {K, V}
+
+    out = Dict{K, V}()
+    sizehint!(out, length(keys))
+
+    for i in eachindex(keys, values)
+        @inbounds out[keys[i]] = values[i]
+    end
+
+    return out
+end
+
 """
 `new_set(::Type, ::Integer) -> Set`
 
@@ -82,6 +226,15 @@ function new_set(value_t::Type, sizehint_maybe::Integer = 0)
     return out;
 end
 
+"""
+`new_set(values::AbstractVector{T}) -> Set{T}`
+
+create new set from array of values
+"""
+function new_set(values::AbstractVector{T}) ::Set{T} where T
+    return Set{T}(values)
+end
+
 """
 `forward_as_pointer(t::Type, ::Ptr{Cvoid}) -> Ptr{t}`
 """
@@ -5,21 +5,75 @@ offers julia-side memory management for C++ jluna
 """
 module memory_handler
 
-    const _current_id = Ref(UInt64(0)) # modified atomically through locks
-    const _refs = Ref(Dict{UInt64, Base.RefValue{Any}}())
-    const _ref_counter = Ref(Dict{UInt64, UInt64}())
+    # references are held in slots of fixed-size slabs. Slabs are never moved or reallocated,
+    # which allows C++ to index them directly, c.f. jluna::detail::get_reference
+    const _slab_size = 1024 # has to match jluna::detail::_reference_slab_size
+    const _max_n_slabs = 4096
+
+    # upper 8 bits of a key are the generation of its slot, the next 8 bits the shard, lower 48 bits the key local to that shard
+    const _shard_shift = 48 # has to match jluna::detail::_reference_shard_shift
+    const _shard_mask = UInt64(0xFF) # has to match jluna::detail::_reference_shard_mask
+    const _generation_shift = 56 # has to match jluna::detail::_reference_generation_shift
+    const _local_key_mask = (UInt64(1) << _shard_shift) - 1
+    const _max_n_shards = Int64(_shard_mask) + 1
+
+    # slot table, freed keys are recycled. Each slot has a generation that is increased when it is freed,
+    # so a key that outlived its slot can be told apart from the key that currently owns it
+    mutable struct ReferenceTable
+        _slabs::Vector{Vector{Any}}
+        _generations::Vector{Vector{UInt8}}
+        _n_slabs::Int64
+        _n_slots::UInt64
+        _free_keys::Vector{UInt64}
+        _n_alive::Int64
+        _lock::Base.Threads.SpinLock
+
+        ReferenceTable() = new(Vector{Vector{Any}}(undef, _max_n_slabs), Vector{Vector{UInt8}}(undef, _max_n_slabs), 0, 0, UInt64[], 0, Base.Threads.SpinLock())
+    end
+
+    # one table per thread, so threads creating proxies concurrently do not contend on the same lock
+    struct ReferenceStore
+        _shards::Vector{ReferenceTable}
+        _shard_slabs::Vector{Vector{Vector{Any}}}
+        _shard_generations::Vector{Vector{Vector{UInt8}}}
+
+        function ReferenceStore(n_shards::Integer)
+            shards = [ReferenceTable() for _ in 1:min(n_shards, _max_n_shards)]
+            return new(shards, [shard._slabs for shard in shards], [shard._generations for shard in shards])
+        end
+    end
+
+    # number of references currently held
+    Base.length(table::ReferenceTable) = table._n_alive
+    Base.length(store::ReferenceStore) = sum(length, store._shards)
+
+    const _refs = Ref(ReferenceStore(Threads.nthreads()))
+
+    # get table, slab, generations of the slab and 1-based index of the slot for key
+    function _get_slot(key::UInt64) ::Tuple{ReferenceTable, Vector{Any}, Vector{UInt8}, Int64}
+
+        table = _refs[]._shards[((key >> _shard_shift) & _shard_mask) + 1]
+        slab, index = divrem((key & _local_key_mask) - 1, _slab_size)
+        return table, table._slabs[slab + 1], table._generations[slab + 1], index + 1
+    end
+
+    # generation the key was created with
+    _get_generation(key::UInt64) ::UInt8 = return UInt8(key >> _generation_shift)
+
+    # strip generation from key
+    _without_generation(key::UInt64) ::UInt64 = return key & ~(_shard_mask << _generation_shift)
 
-    const _refs_lock = Base.ReentrantLock()
-    const _refs_counter_lock = Base.ReentrantLock()
+    # check if the slot of key was not freed since key was created
+    _is_alive(key::UInt64, slab::Vector{Any}, generations::Vector{UInt8}, index::Integer) ::Bool = return generations[index] == _get_generation(key) && !isnothing(slab[index])
 
     const _ref_id_marker = '#'
-    const _refs_expression = Meta.parse("jluna.memory_handler._refs[]")
+    const _get_reference_expression = Meta.parse("jluna.memory_handler.get_reference")
 
     # proxy id that is actually an expression, the ID of topmodule Main is
     ProxyID = Union{Expr, Symbol, Nothing}
 
     # make as unnamed
-    make_unnamed_proxy_id(id::UInt64) = return Expr(:ref, Expr(:ref, _refs_expression, id))
+    make_unnamed_proxy_id(id::UInt64) = return Expr(:ref, Expr(:call, _get_reference_expression, id))
 
     # make as named with owner and symbol name
     function make_named_proxy_id(id::Symbol, owner_id::ProxyID) ::ProxyID
@@ -73,11 +127,11 @@ module memory_handler
         end
 
         out = string(id)
-        reg = r"\Q((jluna.memory_handler._refs[])[\E(.*)\Q])[]\E"
+        reg = r"\(?\Qjluna.memory_handler.get_reference(\E([^)]*)\)\)?\Q[]\E"
         captures = match(reg, out)
 
         if captures != nothing
-            out = replace(out, reg => "<unnamed proxy #" * string(tryparse(Int64, captures.captures[1])) * ">")
+            out = replace(out, reg => "<unnamed proxy #" * string(tryparse(UInt64, captures.captures[1])) * ">")
         end
 
         return out;
@@ -95,73 +149,116 @@ module memory_handler
     function print_refs() ::Nothing
 
         println("jluna.memory_handler._refs: ");
-        for e in _refs[]
-            println("\t", Int64(e.first), " => ", e.second[], " (", typeof(e.second[]), ") ")
+        for (shard, table) in enumerate(_refs[]._shards)
+            for local_key in UInt64(1):table._n_slots
+
+                key = (UInt64(shard - 1) << _shard_shift) | local_key
+                _, slab, generations, index = _get_slot(key)
+                key |= UInt64(generations[index]) << _generation_shift
+
+                if !isnothing(slab[index])
+                    println("\t", key, " => ", slab[index][], " (", typeof(slab[index][]), ") ")
+                end
+            end
         end
     end
 
     """
-    `create_reference(::Ptr{Cvoid}, ::Any) -> UInt64`
+    `create_reference(::Ptr{Cvoid}) -> UInt64`
 
-    add reference to _refs
+    add reference to the shard of the current thread, reusing a freed slot if possible
     """
     function create_reference(to_wrap::Ptr{Cvoid}) ::UInt64
 
-        lock(_refs_lock)
-        lock(_refs_counter_lock)
+        value = Base.RefValue{Any}(unsafe_pointer_to_objref(to_wrap))
+
+        shards = _refs[]._shards
+        shard = mod1(Threads.threadid(), length(shards))
+        table = shards[shard]
+
+        lock(table._lock)
+
+        if isempty(table._free_keys)
 
-        global _current_id[] += 1
-        key::UInt64 = _current_id[];
+            if table._n_slots == table._n_slabs * _slab_size
 
-        if (haskey(_refs[], key))
-            _ref_counter[][key] += 1
+                if table._n_slabs == _max_n_slabs
+                    unlock(table._lock)
+                    throw(ErrorException("In jluna.memory_handler.create_reference: maximum number of references exceeded"))
+                end
+
+                table._n_slabs += 1
+                table._slabs[table._n_slabs] = Vector{Any}(nothing, _slab_size)
+                table._generations[table._n_slabs] = zeros(UInt8, _slab_size)
+            end
+
+            table._n_slots += 1
+            key = (UInt64(shard - 1) << _shard_shift) | table._n_slots
         else
-            _refs[][key] = Base.RefValue{Any}(unsafe_pointer_to_objref(to_wrap))
-            _ref_counter[][key] = 1
+            key = pop!(table._free_keys)
         end
 
-        unlock(_refs_lock)
-        unlock(_refs_counter_lock)
+        _, slab, generations, index = _get_slot(key)
+        slab[index] = value
+        table._n_alive += 1
 
-        return key;
+        unlock(table._lock)
+        return key | (UInt64(generations[index]) << _generation_shift);
     end
 
     create_reference(_::Nothing) ::UInt64 = return 0
 
     """
-    `set_reference(::UInt64, ::T) -> Nothing`
+    `set_reference(::UInt64, ::T) -> Base.RefValue{Any}`
 
     update the value of a reference in _refs without adding a new entry or changing it's key, ref pointers C++ side stay valid
     """
     function set_reference(key::UInt64, new_value::T) ::Base.RefValue{Any} where T
 
-        lock(_refs_lock)
-        result = begin _refs[][key] = Base.RefValue{Any}(new_value) end
-        unlock(_refs_lock)
+        table, slab, generations, index = _get_slot(key)
+
+        lock(table._lock)
+
+        if !_is_alive(key, slab, generations, index)
+            unlock(table._lock)
+            throw(ErrorException("In jluna.memory_handler.set_reference: reference " * string(key) * " was already freed"))
+        end
+
+        result = slab[index]
+        result[] = new_value
+        unlock(table._lock)
         return result
     end
 
     """
-    `get_reference(::Int64) -> Any`
+    `get_reference(::Integer) -> Any`
 
     access reference in _refs
     """
-    function get_reference(key::UInt64) ::Any
+    function get_reference(key::Integer) ::Any
 
         if (key == 0)
             return nothing
         end
 
-        lock(_refs_lock)
-        result = _refs[][key]
-        unlock(_refs_lock)
+        table, slab, generations, index = _get_slot(UInt64(key))
+
+        lock(table._lock)
+
+        if !_is_alive(UInt64(key), slab, generations, index)
+            unlock(table._lock)
+            throw(ErrorException("In jluna.memory_handler.get_reference: reference " * string(key) * " was already freed"))
+        end
+
+        result = slab[index]
+        unlock(table._lock)
         return result
     end
 
     """
     `free_reference(::UInt64) -> Nothing`
 
-    free reference from _refs
+    free reference from _refs, its slot may be reused. Freeing a key that was already freed has no effect
     """
     function free_reference(key::UInt64) ::Nothing
 
@@ -169,24 +266,21 @@ module memory_handler
             return nothing;
         end
 
-        lock(_refs_lock)
+        table, slab, generations, index = _get_slot(key)
+        lock(table._lock)
 
-        if _refs[][key][] isa Module
-            unlock(_refs_lock)
+        # the slot may already belong to a different key
+        if !_is_alive(key, slab, generations, index) || slab[index][] isa Module
+            unlock(table._lock)
             return
         end
 
-        lock(_refs_counter_lock)
-        global _ref_counter[][key] -= 1
-        count::UInt64 = _ref_counter[][key]
+        slab[index] = nothing
+        generations[index] += 0x1
+        push!(table._free_keys, _without_generation(key))
+        table._n_alive -= 1
 
-        if (count == 0)
-            delete!(_ref_counter[], key)
-            delete!(_refs[], key)
-        end
-
-        unlock(_refs_lock)
-        unlock(_refs_counter_lock)
+        unlock(table._lock)
         return nothing;
     end
 
@@ -197,16 +291,21 @@ module memory_handler
     """
     function force_free() ::Nothing
 
-        lock(_refs_lock)
-        lock(_refs_counter_lock)
+        for table in _refs[]._shards
 
-        for k in keys(_refs)
-            delete!(_refs[], k)
-            delete!(_ref_counter[], k)
-        end
+            lock(table._lock)
 
-        unlock(_refs_lock)
-        unlock(_refs_counter_lock)
+            for i in 1:table._n_slabs
+                fill!(table._slabs[i], nothing)
+                table._generations[i] .+= 0x1
+            end
+
+            empty!(table._free_keys)
+            table._n_slots = 0
+            table._n_alive = 0
+
+            unlock(table._lock)
+        end
         return nothing;
     end
 
@@ -30,7 +30,7 @@ module cppcall
         #  1: (Any) -> Any
         #  2: (Any, Any) -> Any
         #  3: (Any, Any, Any) -> Any
-        # all others invalid
+        #  n: (Any, ..., Any) -> Any
 
         function UnnamedFunction{N}(ptr::Ptr{Cvoid}) where N
 
@@ -53,27 +53,32 @@ module cppcall
     end
 
     """
-    `invoke_function(::UnnamedFunction) -> Ptr{Any}`
+    `invoke_function(::UnnamedFunction, xs...) -> Any`
 
-    invoke function with 0 args
+    invoke function with 0 args. Arguments are passed as `Any`, so they stay rooted for the duration of the ccall
     """
-    function invoke_function(f::UnnamedFunction{0}) ::Ptr{Any}
-        return ccall((:jluna_invoke_lambda_0, cppcall._lib), Ptr{Any}, (Ptr{Cvoid},), f._native_handle);
+    function invoke_function(f::UnnamedFunction{0})
+        return ccall((:jluna_invoke_lambda_0, cppcall._lib), Any, (Ptr{Cvoid},), f._native_handle);
     end
 
     # overload for 1 arg
-    function invoke_function(f::UnnamedFunction{1}, arg1::Ptr{Any}) ::Ptr{Any}
-        return ccall((:jluna_invoke_lambda_1, cppcall._lib), Ptr{Any}, (Ptr{Cvoid}, Ptr{Any}), f._native_handle, arg1);
+    function invoke_function(f::UnnamedFunction{1}, arg1)
+        return ccall((:jluna_invoke_lambda_1, cppcall._lib), Any, (Ptr{Cvoid}, Any), f._native_handle, arg1);
     end
 
     # overload for 2 args
-    function invoke_function(f::UnnamedFunction{2}, arg1::Ptr{Any}, arg2::Ptr{Any}) ::Ptr{Any}
-        return ccall((:jluna_invoke_lambda_2, cppcall._lib), Ptr{Any}, (Ptr{Cvoid}, Ptr{Any}, Ptr{Any}), f._native_handle, arg1, arg2);
+    function invoke_function(f::UnnamedFunction{2}, arg1, arg2)
+        return ccall((:jluna_invoke_lambda_2, cppcall._lib), Any, (Ptr{Cvoid}, Any, Any), f._native_handle, arg1, arg2);
     end
 
     # overload for 3 args
-    function invoke_function(f::UnnamedFunction{3}, arg1::Ptr{Any}, arg2::Ptr{Any}, arg3::Ptr{Any}) ::Ptr{Any}
-        return ccall((:jluna_invoke_lambda_3, cppcall._lib), Ptr{Any}, (Ptr{Cvoid}, Ptr{Any}, Ptr{Any}, Ptr{Any}), f._native_handle, arg1, arg2, arg3);
+    function invoke_function(f::UnnamedFunction{3}, arg1, arg2, arg3)
+        return ccall((:jluna_invoke_lambda_3, cppcall._lib), Any, (Ptr{Cvoid}, Any, Any, Any), f._native_handle, arg1, arg2, arg3);
+    end
+
+    # overload for n > 3 args, the ccall signature is generated per arity. Arguments are passed as a pointer to a tuple of object pointers
+    @generated function invoke_function(f::UnnamedFunction{N}, xs::Vararg{Any, N}) where N
+        return :(ccall((:jluna_invoke_lambda_n, cppcall._lib), Any, (Ptr{Cvoid}, Ref{NTuple{$N, Any}}, Csize_t), f._native_handle, Ref{NTuple{$N, Any}}(xs), $N))
     end
 
     """
@@ -103,34 +108,110 @@ module cppcall
 
         n = length(xs)
 
-        if n == N == 0
-            return from_pointer(invoke_function(f));
-        elseif n == N == 1
-            return from_pointer(invoke_function(f, to_pointer(xs[1])));
-        elseif n == N == 2
-            return from_pointer(invoke_function(f, to_pointer(xs[1]), to_pointer(xs[2])));
-        elseif n == N == 3
-            return from_pt(invoke_function(f, to_pointer(xs[1]), to_pointer(xs[2]), to_pointer(xs[3])));
-        elseif N != 0 && N != 1 && N != 2 & N != 3
-            return from_pointer(invoke_function(f, to_pointer([xs...])));
-        else
+        if n != N
             throw(ErrorException(
                 "MethodError: when trying to invoke <C++ Lambda#" * string(f._native_handle) * ">" *
                 ": wrong number of arguments. expected " * string(N) * ", got " * string(n) * "."
-               *  (n <= 3 ? "" : "\n\nTo create a C++-function that can take n > 3 arguments, simply make a 1-argument function with the only argument being an n-sized tuple or collection.")
             ))
         end
+
+        return invoke_function(f, xs...)
+    end
+
+
+    """
+    object that is callable like a function, but executes C++-side code. Arguments and result are passed by value through a typed ccall
+    """
+    mutable struct TypedUnnamedFunction{Return_t, Args_t <: Tuple}
+
+        _native_handle::Ptr{Cvoid}
+        # points to C-side function object
+
+        _invoke::Ptr{Cvoid}
+        # points to C-side function (Ptr{Cvoid}, Args_t...) -> Return_t
+
+        _free::Ptr{Cvoid}
+        # points to C-side function (Ptr{Cvoid}) -> Cvoid, deallocates _native_handle
+
+        function TypedUnnamedFunction{R, Args}(ptr::Ptr{Cvoid}, invoke::Ptr{Cvoid}, free::Ptr{Cvoid}) where {R, Args <: Tuple}
+
+            out = new{R, Args}(ptr, invoke, free)
+            finalizer(function (t::TypedUnnamedFunction{R, Args})
+                ccall(t._free, Cvoid, (Ptr{Cvoid},), t._native_handle)
+            end, out);
+
+            return out;
+        end
+    end
+
+    """
+    `make_typed_unnamed_function(::Ptr{Cvoid}, ::Ptr{Cvoid}, ::Ptr{Cvoid}, ::Type, ::Type...) -> TypedUnnamedFunction`
+
+    wrapper for TypedUnnamedFunction ctor
+    """
+    function make_typed_unnamed_function(ptr::Ptr{Cvoid}, invoke::Ptr{Cvoid}, free::Ptr{Cvoid}, return_t::Type, arg_ts::Type...)
+        return TypedUnnamedFunction{return_t, Tuple{arg_ts...}}(ptr, invoke, free)
     end
 
+    """
+    `TypedUnnamedFunction(xs...) -> Return_t`
+
+    invoke TypedUnnamedFunction, the ccall signature is generated per function type
+    """
+    @generated function (f::TypedUnnamedFunction{R, Args})(xs...) where {R, Args}
+
+        arg_ts = Args.parameters
+        n = length(xs)
+        N = length(arg_ts)
+
+        if n != N
+            return :(throw(ErrorException(
+                "MethodError: when trying to invoke <C++ Lambda#" * string(f._native_handle) * ">" *
+                ": wrong number of arguments. expected " * string($N) * ", got " * string($n) * "."
+            )))
+        end
+
+        return :(ccall(f._invoke, $R, (Ptr{Cvoid}, $(arg_ts...)), f._native_handle, $([:(xs[$i]) for i in 1:N]...)))
+    end
 
     """
     `make_task(::UInt64) -> Task`
+
+    create a non-sticky task that invokes a C++-side detail::TaskFunction, the task fails if the function threw
     """
     function make_task(ptr::UInt64)
-        return Task() do;
+        task = Task() do;
             res_ptr = ccall((:jluna_invoke_from_task, _lib), Csize_t, (Csize_t,), ptr);
+            res_ptr == 0 && error("In jluna.cppcall.make_task: C++-side task function threw an exception")
             return unsafe_pointer_to_objref(Ptr{Any}(res_ptr))
         end
+        task.sticky = false
+        return task
+    end
+
+    """
+    `make_tasks(::Vector{UInt64}) -> Vector{Task}`
+
+    create one task per C++-side detail::TaskFunction, see make_task
+    """
+    function make_tasks(ptrs::Vector{UInt64}) ::Vector{Task}
+        out = Vector{Task}(undef, length(ptrs))
+        for i in eachindex(ptrs)
+            out[i] = make_task(ptrs[i])
+        end
+        return out
+    end
+
+    """
+    `schedule_tasks(::Vector{Any}) -> Nothing`
+
+    schedule all tasks in order
+    """
+    function schedule_tasks(tasks::Vector{Any}) ::Nothing
+        for task in tasks
+            schedule(task)
+        end
+        return nothing
     end
 end
 
@@ -187,6 +268,40 @@ function implement(template::Proxy, m::Module = Main) ::Type
     return m.eval(template._typename)
 end
 
+"""
+`implement_isbits(::Symbol, ::Vector{Symbol}, ::Vector{Any}, ::Vector{UInt64}, ::UInt64, ::Module) -> Type`
+
+translate a usertype into an immutable isbits julia type, verifying that its memory layout matches that of the C++-side type
+"""
+function implement_isbits(name::Symbol, fieldnames::Vector{Symbol}, fieldtypes::Vector{Any}, offsets::Vector{UInt64}, size::UInt64, m::Module = Main) ::Type
+
+    out::Expr = :(struct $name end)
+    deleteat!(out.args[3].args, 1)
+
+    for i in eachindex(fieldnames)
+        push!(out.args[3].args, Expr(:(::), fieldnames[i], fieldtypes[i]))
+    end
+
+    Base.eval(m, out)
+    type = m.eval(name)
+
+    if !isbitstype(type)
+        error("In jluna.implement_isbits: type " * string(name) * " is not isbits, all of its fields need to be isbits")
+    end
+
+    for i in eachindex(offsets)
+        if fieldoffset(type, i) != offsets[i]
+            error("In jluna.implement_isbits: offset of field " * string(fieldnames[i]) * " is " * string(Int64(fieldoffset(type, i))) * " Julia-side but " * string(offsets[i]) * " C++-side")
+        end
+    end
+
+    if sizeof(type) != size
+        error("In jluna.implement_isbits: size of type " * string(name) * " is " * string(sizeof(type)) * " Julia-side but " * string(size) * " C++-side, all members of the C++-side type need to be added as fields")
+    end
+
+    return type
+end
+
 """
 `setindex!(::Proxy, <:Any, ::Symbol) -> Nothing`
 extend base.setindex!
@@ -9,10 +9,13 @@
 #include <include/concepts.hpp>
 #include <include/unbox.hpp>
 #include <include/box.hpp>
+#include <.src/task_pool.hpp>
 
 #include <thread>
 #include <optional>
 #include <condition_variable>
+#include <functional>
+#include <tuple>
 
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -53,6 +56,9 @@ namespace jluna
         template<typename>struct TaskValue;
     }
 
+    template<typename>
+    class Task;
+
     /// @brief the result of a thread
     template<typename Value_t>
     class Future
@@ -77,19 +83,49 @@ namespace jluna
             /// @returns value, if task failed, optional will not contain a value
             std::optional<Value_t> wait();
 
+            /// @brief create a task that is scheduled automatically once the value becomes available
+            /// @param f: function with signature (Value_t) -> T, invoked with a copy of the value. Move-only values are moved into f
+            /// @returns Task<T>, scheduled by jluna. It may go out of scope before it is done, the task still runs
+            /// @note only one of then, when_all or when_any can be attached to the same future. If the task of this future fails, the returned task is scheduled regardless and fails
+            template<typename Function_t, typename Return_t = std::invoke_result_t<Function_t, Value_t&&>>
+            [[nodiscard]] Task<Return_t> then(Function_t f);
+
         private:
-            void set_value(Value_t);
+            // invoked with _mutex held, the optional contains no value if the task failed. Returns the Julia-side task to schedule, or nullptr
+            using Continuation = std::function<unsafe::Value*(std::optional<Value_t>&)>;
+
+            void set_value(Value_t&&);
+            void set_failed();
+            void set(std::optional<Value_t>&&);
+            void set_continuation(Continuation&&);
 
             std::mutex _mutex;
             std::condition_variable _cv;
-            std::unique_lock<std::mutex> _cv_lock;
-            std::unique_ptr<Value_t> _value;
+            std::optional<Value_t> _value;
+            bool _is_set = false;
+            Continuation _continuation;
+            bool _has_continuation = false;
     };
 
+    /// @brief create a task that is scheduled automatically once all futures have a value
+    /// @param futures: futures, each value is copied into the result
+    /// @returns Task<std::tuple<Ts...>>, scheduled by jluna. It may go out of scope before it is done, the task still runs
+    /// @note only one of then, when_all or when_any can be attached to the same future. If any of the tasks fail, the returned task fails
+    template<typename... Ts>
+    [[nodiscard]] Task<std::tuple<Ts...>> when_all(Future<Ts>&... futures);
+
+    /// @brief create a task that is scheduled automatically once the first of the futures has a value
+    /// @param futures: futures of the same value type
+    /// @returns Task<std::pair<uint64_t, T>>, where .first is the index of the future and .second a copy of its value. Scheduled by jluna, it may go out of scope before it is done
+    /// @note only one of then, when_all or when_any can be attached to the same future. The returned task fails only if all of the tasks fail
+    template<typename T, typename... Ts>
+    [[nodiscard]] Task<std::pair<uint64_t, T>> when_any(Future<T>& first, Future<Ts>&... rest);
+
     template<typename Result_t>
     class Task
     {
         friend class ThreadPool;
+        friend struct detail::FutureHandler;
 
         public:
             /// @brief dtor
@@ -149,6 +185,7 @@ namespace jluna
     {
         template<typename>
         friend class Task;
+        friend struct detail::FutureHandler;
 
         public:
             /// @brief create a task from a std::function returning void
@@ -177,6 +214,20 @@ namespace jluna
             >
             [[nodiscard]] static Task<T> create(Lambda_t f, Args_t... args);
 
+            /// @brief create n tasks at once, task i invokes f(i)
+            /// @param n: number of tasks
+            /// @param f: function with signature (uint64_t) -> T, shared between all tasks
+            /// @returns vector of Task<T>, not yet scheduled
+            /// @note all Julia-side tasks are created with a single call into Julia, use this over calling create in a loop
+            template<typename Function_t, typename Return_t = std::invoke_result_t<Function_t, uint64_t>>
+            [[nodiscard]] static std::vector<Task<Return_t>> create_batch(uint64_t n, Function_t f);
+
+            /// @brief start all tasks
+            /// @param tasks: tasks, invalidated tasks are skipped
+            /// @note all tasks are scheduled with a single call into Julia, use this over calling Task::schedule in a loop
+            template<typename Return_t>
+            static void schedule_batch(std::vector<Task<Return_t>>& tasks);
+
             /// @brief get number of threads
             /// @returns number
             static uint64_t n_threads();
@@ -186,15 +237,17 @@ namespace jluna
             static uint64_t thread_id();
 
         private:
+            template<typename Return_t, typename Lambda_t>
+            static Task<Return_t> create_task(Lambda_t&&);
+
+            template<typename Return_t, typename Lambda_t>
+            static auto* allocate_task(Lambda_t&&);
+
+            static void retain(uint64_t id);
             static void free(uint64_t id);
+            static void discard(uint64_t id);
 
-            static inline uint64_t _current_id = 0;
-            static inline std::mutex _storage_lock = std::mutex();
-            static inline std::map<uint64_t,
-                std::pair<
-                    detail::TaskSuper*,
-                    std::unique_ptr<std::function<unsafe::Value*()>>
-                >> _storage = {};
+            static inline detail::TaskPool _pool = {};
     };
 
     /// @brief pause the current task, has to be called from within a task allocated via ThreadPool::create
@@ -0,0 +1,47 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#pragma once
+
+#include <include/concepts.hpp>
+#include <include/array.hpp>
+#include <include/multi_threading.hpp>
+
+namespace jluna
+{
+    /// @brief invoke function once for every index in [0, n), distributed across all Julia threads
+    /// @param n: number of indices
+    /// @param f: function with signature (uint64_t) -> void, may not throw and may not access the Julia state
+    /// @param grain_size: [optional] number of consecutive indices processed at once, chosen automatically if 0
+    /// @note work is split into grains, idle threads steal grains from busy threads
+    template<typename Function_t, std::enable_if_t<std::is_invocable_v<Function_t, uint64_t>, bool> = true>
+    void parallel_for(uint64_t n, Function_t f, uint64_t grain_size = 0);
+
+    /// @brief invoke function on every element of an array, distributed across all Julia threads
+    /// @param array: array, its value type has to match the Julia-side value type
+    /// @param f: function with signature (Value_t&) -> void, may not throw and may not access the Julia state
+    /// @param grain_size: [optional] number of consecutive elements processed at once, chosen automatically if 0
+    /// @note elements are accessed through the raw array data, not through Array::Iterator
+    template<is_isbits_compatible Value_t, uint64_t Rank, typename Function_t>
+    void parallel_for(Array<Value_t, Rank>& array, Function_t f, uint64_t grain_size = 0);
+
+    /// @brief assign out[i] = f(in[i]) for all elements, distributed across all Julia threads
+    /// @param in: array, its value type has to match the Julia-side value type
+    /// @param out: array of the same number of elements, its value type has to match the Julia-side value type
+    /// @param f: function with signature (In_t) -> Out_t, may not throw and may not access the Julia state
+    /// @param grain_size: [optional] number of consecutive elements processed at once, chosen automatically if 0
+    template<is_isbits_compatible In_t, is_isbits_compatible Out_t, uint64_t Rank, typename Function_t>
+    void parallel_transform(const Array<In_t, Rank>& in, Array<Out_t, Rank>& out, Function_t f, uint64_t grain_size = 0);
+
+    /// @brief reduce all elements using a binary operator, distributed across all Julia threads
+    /// @param array: array, its value type has to match the Julia-side value type
+    /// @param init: initial value
+    /// @param op: function with signature (Value_t, Value_t) -> Value_t, has to be associative and commutative, may not throw and may not access the Julia state
+    /// @param grain_size: [optional] number of consecutive elements processed at once, chosen automatically if 0
+    /// @returns result of reduction
+    template<is_isbits_compatible Value_t, uint64_t Rank, typename Function_t>
+    Value_t parallel_reduce(const Array<Value_t, Rank>& array, Value_t init, Function_t op, uint64_t grain_size = 0);
+}
+
+#include <.src/parallel_algorithms.inl>
@@ -85,10 +85,10 @@ namespace jluna
             /// @brief cast to string using Julia's Base.string
             virtual operator std::string() const;
 
-            /// @brief implicitly convert to T via unboxing
+            /// @brief implicitly convert to T via unboxing, explicit for std::string_view, which aliases the proxies value
             /// @returns value as T
             template<is_unboxable T, std::enable_if_t<not std::is_same_v<T, std::string>, bool> = true>
-            operator T() const;
+            explicit(std::is_same_v<T, std::string_view>) operator T() const;
 
             /// @brief implicitly downcast to base
             /// @returns value as T
@@ -185,6 +185,13 @@ namespace jluna
             /// @returns pointer to jluna.memory_handler.ProxyID
             unsafe::Value* id() const;
 
+            /// @brief get generation, incremented every time the value is reassigned or resized through jluna
+            /// @returns generation
+            uint64_t generation() const;
+
+            /// @brief increment generation, invalidates metadata cached by specialized proxies
+            void increment_generation();
+
         protected:
             /// @brief ctor without owner
             /// @param value: pointer to value
@@ -216,6 +223,8 @@ namespace jluna
 
             mutable unsafe::Value* _id_ref;
             mutable unsafe::Value* _value_ref;
+
+            uint64_t _generation = 0;
     };
 }
 
@@ -0,0 +1,424 @@
+//
+// Copyright 2022 Clemens Cords
+//
+
+#pragma once
+
+#include <include/concepts.hpp>
+#include <include/typedefs.hpp>
+#include <include/array.hpp>
+
+#include <concepts>
+#include <tuple>
+
+namespace jluna::simd
+{
+    /// @brief type of the result of simd::sum: Int64 for signed integers, UInt64 for unsigned integers, the element type for floats. Mirrors Base.sum
+    template<is_simd_compatible T>
+    using sum_t = std::conditional_t<std::is_floating_point_v<T>, T, std::conditional_t<std::is_signed_v<T>, Int64, UInt64>>;
+
+    /// @brief assign out[i] = a[i] + b[i], equivalent to Julia-side out .= a .+ b
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @param b: array of the same number of elements
+    /// @param out: array of the same number of elements, may be the same array as a or b
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<is_simd_compatible T, uint64_t Rank>
+    void add(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<T, Rank>& out);
+
+    /// @brief assign out[i] = a[i] - b[i], equivalent to Julia-side out .= a .- b
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @param b: array of the same number of elements
+    /// @param out: array of the same number of elements, may be the same array as a or b
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<is_simd_compatible T, uint64_t Rank>
+    void subtract(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<T, Rank>& out);
+
+    /// @brief assign out[i] = a[i] * b[i], equivalent to Julia-side out .= a .* b
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @param b: array of the same number of elements
+    /// @param out: array of the same number of elements, may be the same array as a or b
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<is_simd_compatible T, uint64_t Rank>
+    void multiply(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<T, Rank>& out);
+
+    /// @brief assign out[i] = fma(a[i], b[i], c[i]), equivalent to Julia-side out .= fma.(a, b, c)
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @param b: array of the same number of elements
+    /// @param c: array of the same number of elements
+    /// @param out: array of the same number of elements, may be the same array as a, b or c
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    /// @note for floats, the result is rounded once, on CPUs without FMA instructions this is considerably slower than multiply followed by add
+    template<is_simd_compatible T, uint64_t Rank>
+    void fma(const Array<T, Rank>& a, const Array<T, Rank>& b, const Array<T, Rank>& c, Array<T, Rank>& out);
+
+    /// @brief sum of all elements, equivalent to Julia-side sum(a)
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @returns sum
+    /// @exceptions throws std::invalid_argument if the value type does not match
+    /// @note for floats, elements are summed in a different order than Base.sum, so the result may differ by rounding
+    template<is_simd_compatible T, uint64_t Rank>
+    sum_t<T> sum(const Array<T, Rank>& a);
+
+    /// @brief smallest element, equivalent to Julia-side minimum(a)
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @returns minimum, NaN if any element is NaN
+    /// @exceptions throws std::invalid_argument if the value type does not match or the array is empty
+    template<is_simd_compatible T, uint64_t Rank>
+    T minimum(const Array<T, Rank>& a);
+
+    /// @brief largest element, equivalent to Julia-side maximum(a)
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @returns maximum, NaN if any element is NaN
+    /// @exceptions throws std::invalid_argument if the value type does not match or the array is empty
+    template<is_simd_compatible T, uint64_t Rank>
+    T maximum(const Array<T, Rank>& a);
+
+    /// @brief sum of a[i] * b[i], equivalent to Julia-side LinearAlgebra.dot(a, b)
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @param b: array of the same number of elements
+    /// @returns dot product
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<is_simd_compatible T, uint64_t Rank>
+    T dot(const Array<T, Rank>& a, const Array<T, Rank>& b);
+
+    /// @brief assign out[i] = a[i] == b[i], equivalent to Julia-side out .= a .== b
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @param b: array of the same number of elements
+    /// @param out: array of Bool of the same number of elements
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<is_simd_compatible T, uint64_t Rank>
+    void equal(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<bool, Rank>& out);
+
+    /// @brief assign out[i] = a[i] < b[i], equivalent to Julia-side out .= a .< b
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @param b: array of the same number of elements
+    /// @param out: array of Bool of the same number of elements
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<is_simd_compatible T, uint64_t Rank>
+    void less(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<bool, Rank>& out);
+
+    /// @brief assign out[i] = a[i] > b[i], equivalent to Julia-side out .= a .> b
+    /// @param a: array, its value type has to match the Julia-side value type
+    /// @param b: array of the same number of elements
+    /// @param out: array of Bool of the same number of elements
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<is_simd_compatible T, uint64_t Rank>
+    void greater(const Array<T, Rank>& a, const Array<T, Rank>& b, Array<bool, Rank>& out);
+}
+
+namespace jluna::detail
+{
+    // kernels operating on raw data, one overload per element type, c.f. .src/simd.cpp
+    #define JLUNA_DECLARE_SIMD_KERNELS(T) \
+        void simd_add(const T* a, const T* b, T* out, uint64_t n); \
+        void simd_subtract(const T* a, const T* b, T* out, uint64_t n); \
+        void simd_multiply(const T* a, const T* b, T* out, uint64_t n); \
+        void simd_fma(const T* a, const T* b, const T* c, T* out, uint64_t n); \
+        simd::sum_t<T> simd_sum(const T* a, uint64_t n); \
+        T simd_minimum(const T* a, uint64_t n); \
+        T simd_maximum(const T* a, uint64_t n); \
+        T simd_dot(const T* a, const T* b, uint64_t n); \
+        void simd_equal(const T* a, const T* b, bool* out, uint64_t n); \
+        void simd_less(const T* a, const T* b, bool* out, uint64_t n); \
+        void simd_greater(const T* a, const T* b, bool* out, uint64_t n);
+
+    JLUNA_DECLARE_SIMD_KERNELS(Int8)
+    JLUNA_DECLARE_SIMD_KERNELS(Int16)
+    JLUNA_DECLARE_SIMD_KERNELS(Int32)
+    JLUNA_DECLARE_SIMD_KERNELS(Int64)
+    JLUNA_DECLARE_SIMD_KERNELS(UInt8)
+    JLUNA_DECLARE_SIMD_KERNELS(UInt16)
+    JLUNA_DECLARE_SIMD_KERNELS(UInt32)
+    JLUNA_DECLARE_SIMD_KERNELS(UInt64)
+    JLUNA_DECLARE_SIMD_KERNELS(Float32)
+    JLUNA_DECLARE_SIMD_KERNELS(Float64)
+
+    #undef JLUNA_DECLARE_SIMD_KERNELS
+
+    enum class SimdOperation
+    {
+        ADD,
+        SUBTRACT,
+        MULTIPLY,
+        EQUAL,
+        LESS,
+        GREATER
+    };
+}
+
+namespace jluna::simd
+{
+    /// @brief number of elements of an expression evaluated at once, intermediate results of one block stay in the L1 cache
+    constexpr uint64_t block_size = 512;
+
+    /// @concept: element-wise expression, c.f. simd::expr
+    template<typename T>
+    concept is_expression = requires(const T& t, uint64_t i, typename T::value_type* buffer)
+    {
+        {t.size()} -> std::convertible_to<uint64_t>;
+        {t.evaluate(i, i, buffer)} -> std::convertible_to<const typename T::value_type*>;
+    };
+
+    /// @brief leaf of an expression, references the data of an array
+    template<is_simd_compatible T>
+    class Operand
+    {
+        public:
+            using value_type = T;
+
+            /// @brief ctor
+            /// @param array: array, its value type has to match the Julia-side value type. Has to stay in scope until the expression was evaluated
+            /// @exceptions throws std::invalid_argument if the value type does not match
+            template<uint64_t Rank>
+            explicit Operand(const Array<T, Rank>& array);
+
+            /// @brief get number of elements
+            /// @returns size
+            uint64_t size() const;
+
+            /// @brief evaluate elements [offset, offset + n)
+            /// @param offset: index of first element
+            /// @param n: number of elements, at most simd::block_size
+            /// @param buffer: unused
+            /// @returns pointer to the elements of the array
+            const T* evaluate(uint64_t offset, uint64_t n, T* buffer) const;
+
+        private:
+            const T* _data;
+            uint64_t _size;
+    };
+
+    /// @brief element-wise arithmetic expression, c.f. simd::add, simd::subtract, simd::multiply
+    template<is_expression Lhs, is_expression Rhs, detail::SimdOperation Operation>
+    class ArithmeticExpression
+    {
+        public:
+            using value_type = typename Lhs::value_type;
+
+            /// @brief ctor
+            /// @param lhs: left operand
+            /// @param rhs: right operand, of the same number of elements
+            /// @exceptions throws std::out_of_range if the number of elements does not match
+            ArithmeticExpression(const Lhs& lhs, const Rhs& rhs);
+
+            /// @brief get number of elements
+            /// @returns size
+            uint64_t size() const;
+
+            /// @brief evaluate elements [offset, offset + n)
+            /// @param offset: index of first element
+            /// @param n: number of elements, at most simd::block_size
+            /// @param buffer: memory for at least n elements, the result is written into it
+            /// @returns buffer
+            const value_type* evaluate(uint64_t offset, uint64_t n, value_type* buffer) const;
+
+        private:
+            Lhs _lhs;
+            Rhs _rhs;
+    };
+
+    /// @brief element-wise fused multiply-add expression, c.f. simd::fma
+    template<is_expression A, is_expression B, is_expression C>
+    class FmaExpression
+    {
+        public:
+            using value_type = typename A::value_type;
+
+            /// @brief ctor
+            /// @param a: first factor
+            /// @param b: second factor, of the same number of elements
+            /// @param c: summand, of the same number of elements
+            /// @exceptions throws std::out_of_range if the number of elements does not match
+            FmaExpression(const A& a, const B& b, const C& c);
+
+            /// @brief get number of elements
+            /// @returns size
+            uint64_t size() const;
+
+            /// @brief evaluate elements [offset, offset + n)
+            /// @param offset: index of first element
+            /// @param n: number of elements, at most simd::block_size
+            /// @param buffer: memory for at least n elements, the result is written into it
+            /// @returns buffer
+            const value_type* evaluate(uint64_t offset, uint64_t n, value_type* buffer) const;
+
+        private:
+            A _a;
+            B _b;
+            C _c;
+    };
+
+    /// @brief element-wise comparison, evaluates to Bool. Can only be assigned to an array, not used as an operand of other expressions
+    template<is_expression Lhs, is_expression Rhs, detail::SimdOperation Operation>
+    class ComparisonExpression
+    {
+        public:
+            using value_type = bool;
+
+            /// @brief ctor
+            /// @param lhs: left operand
+            /// @param rhs: right operand, of the same number of elements
+            /// @exceptions throws std::out_of_range if the number of elements does not match
+            ComparisonExpression(const Lhs& lhs, const Rhs& rhs);
+
+            /// @brief get number of elements
+            /// @returns size
+            uint64_t size() const;
+
+            /// @brief evaluate elements [offset, offset + n)
+            /// @param offset: index of first element
+            /// @param n: number of elements, at most simd::block_size
+            /// @param buffer: memory for at least n elements, the result is written into it
+            /// @returns buffer
+            const bool* evaluate(uint64_t offset, uint64_t n, bool* buffer) const;
+
+        private:
+            Lhs _lhs;
+            Rhs _rhs;
+    };
+
+    /// @brief wrap an array so it can be used in an expression
+    /// @param array: array, its value type has to match the Julia-side value type. Has to stay in scope until the expression was evaluated
+    /// @returns operand
+    /// @exceptions throws std::invalid_argument if the value type does not match
+    template<is_simd_compatible T, uint64_t Rank>
+    Operand<T> expr(const Array<T, Rank>& array);
+}
+
+namespace jluna::detail
+{
+    template<simd::is_expression T>
+    const T& as_expression(const T& expression)
+    {
+        return expression;
+    }
+
+    template<is_simd_compatible T, uint64_t Rank>
+    simd::Operand<T> as_expression(const Array<T, Rank>& array)
+    {
+        return simd::Operand<T>(array);
+    }
+
+    template<typename T>
+    using expression_t = std::decay_t<decltype(as_expression(std::declval<const T&>()))>;
+
+    // arrays or expressions of the same number type other than Bool, at least one of them an expression if RequireExpression
+    template<bool RequireExpression, typename... Ts>
+    concept is_simd_operands = requires(const Ts&... ts)
+    {
+        (as_expression(ts), ...);
+    } and (is_simd_compatible<typename expression_t<Ts>::value_type> and ...)
+      and (std::is_same_v<typename expression_t<Ts>::value_type, typename expression_t<std::tuple_element_t<0, std::tuple<Ts...>>>::value_type> and ...)
+      and (not RequireExpression or (simd::is_expression<Ts> or ...));
+}
+
+namespace jluna::simd
+{
+    /// @brief lazily evaluated lhs[i] + rhs[i], c.f. simd::assign
+    /// @param lhs: array or expression
+    /// @param rhs: array or expression of the same number of elements
+    /// @returns expression
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ArithmeticExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::ADD> add(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief lazily evaluated lhs[i] - rhs[i], c.f. simd::assign
+    /// @param lhs: array or expression
+    /// @param rhs: array or expression of the same number of elements
+    /// @returns expression
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ArithmeticExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::SUBTRACT> subtract(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief lazily evaluated lhs[i] * rhs[i], c.f. simd::assign
+    /// @param lhs: array or expression
+    /// @param rhs: array or expression of the same number of elements
+    /// @returns expression
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ArithmeticExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::MULTIPLY> multiply(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief lazily evaluated fma(a[i], b[i], c[i]), c.f. simd::assign
+    /// @param a: array or expression
+    /// @param b: array or expression of the same number of elements
+    /// @param c: array or expression of the same number of elements
+    /// @returns expression
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<typename A, typename B, typename C> requires detail::is_simd_operands<false, A, B, C>
+    FmaExpression<detail::expression_t<A>, detail::expression_t<B>, detail::expression_t<C>> fma(const A& a, const B& b, const C& c);
+
+    /// @brief lazily evaluated lhs[i] == rhs[i], c.f. simd::assign
+    /// @param lhs: array or expression
+    /// @param rhs: array or expression of the same number of elements
+    /// @returns expression of Bool
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ComparisonExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::EQUAL> equal(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief lazily evaluated lhs[i] < rhs[i], c.f. simd::assign
+    /// @param lhs: array or expression
+    /// @param rhs: array or expression of the same number of elements
+    /// @returns expression of Bool
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ComparisonExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::LESS> less(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief lazily evaluated lhs[i] > rhs[i], c.f. simd::assign
+    /// @param lhs: array or expression
+    /// @param rhs: array or expression of the same number of elements
+    /// @returns expression of Bool
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<false, Lhs, Rhs>
+    ComparisonExpression<detail::expression_t<Lhs>, detail::expression_t<Rhs>, detail::SimdOperation::GREATER> greater(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief simd::add, at least one operand has to be an expression
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<true, Lhs, Rhs>
+    auto operator+(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief simd::subtract, at least one operand has to be an expression
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<true, Lhs, Rhs>
+    auto operator-(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief simd::multiply, at least one operand has to be an expression
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<true, Lhs, Rhs>
+    auto operator*(const Lhs& lhs, const Rhs& rhs);
+
+    /// @brief evaluate an expression in a single pass, equivalent to a fused Julia-side broadcast such as out .= a .* b .+ c
+    /// @param out: array of the same number of elements and value type as the expression, may be one of its operands
+    /// @param expression: expression
+    /// @exceptions throws std::invalid_argument if the value type does not match, std::out_of_range if the number of elements does not match
+    /// @note elements are evaluated in blocks of simd::block_size, intermediate results are never written to memory outside the L1 cache
+    template<is_expression Expression_t, uint64_t Rank>
+    void assign(Array<typename Expression_t::value_type, Rank>& out, const Expression_t& expression);
+
+    /// @brief sum of all elements of an expression, evaluated in a single pass
+    /// @param expression: expression
+    /// @returns sum
+    /// @note for floats, elements are summed in a different order than Base.sum, so the result may differ by rounding
+    template<is_expression Expression_t> requires is_simd_compatible<typename Expression_t::value_type>
+    sum_t<typename Expression_t::value_type> sum(const Expression_t& expression);
+
+    /// @brief smallest element of an expression, evaluated in a single pass
+    /// @param expression: expression
+    /// @returns minimum, NaN if any element is NaN
+    /// @exceptions throws std::invalid_argument if the expression is empty
+    template<is_expression Expression_t> requires is_simd_compatible<typename Expression_t::value_type>
+    typename Expression_t::value_type minimum(const Expression_t& expression);
+
+    /// @brief largest element of an expression, evaluated in a single pass
+    /// @param expression: expression
+    /// @returns maximum, NaN if any element is NaN
+    /// @exceptions throws std::invalid_argument if the expression is empty
+    template<is_expression Expression_t> requires is_simd_compatible<typename Expression_t::value_type>
+    typename Expression_t::value_type maximum(const Expression_t& expression);
+
+    /// @brief sum of lhs[i] * rhs[i], evaluated in a single pass
+    /// @param lhs: array or expression
+    /// @param rhs: array or expression of the same number of elements, at least one of lhs and rhs has to be an expression
+    /// @returns dot product
+    /// @exceptions throws std::invalid_argument if a value type does not match, std::out_of_range if the number of elements does not match
+    template<typename Lhs, typename Rhs> requires detail::is_simd_operands<true, Lhs, Rhs>
+    typename detail::expression_t<Lhs>::value_type dot(const Lhs& lhs, const Rhs& rhs);
+}
+
+#include <.src/simd.inl>
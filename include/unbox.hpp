@@ -75,6 +75,11 @@ namespace jluna
     template<is<std::string> T>
     T unbox(unsafe::Value*);
 
+    /// @brief unbox String or Symbol to string view, aliasing the Julia-side bytes without copying
+    /// @note for a String, the view is only valid while the Julia-side value is kept safe from the garbage collector
+    template<is<std::string_view> T>
+    T unbox(unsafe::Value*);
+
     /// @brief unbox to complex
     template<typename T,
         typename Value_t = typename T::value_type,
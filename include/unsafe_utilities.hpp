@@ -9,6 +9,10 @@
 #include <include/concepts.hpp>
 #include <.src/gc_sentinel.hpp>
 
+#include <chrono>
+#include <thread>
+#include <map>
+
 namespace jluna
 {
     /// @brief string suffix operator to create a symbol from a string
@@ -52,6 +56,68 @@ namespace jluna::unsafe
     /// @returns true if active, false otherwise
     bool gc_is_enabled();
 
+    /// @brief RAII guard, disables the GC on construction and restores its state on destruction
+    /// @note guards nest: only the outermost guard of a thread toggles the GC, inner guards only increase the depth. As jl_gc_enable only affects the calling thread, the current task may not yield while a guard is active, this is asserted in debug builds
+    class GCPause
+    {
+        public:
+            /// @brief ctor, pause GC if this is the outermost guard of the current thread
+            /// @param file: [optional] source file, used to attribute the pause for gc_pause_statistics
+            /// @param line: [optional] source line, used to attribute the pause for gc_pause_statistics
+            /// @exceptions throws std::runtime_error if the calling thread is not known to Julia
+            GCPause(const char* file = "<unknown>", uint64_t line = 0);
+
+            /// @brief dtor, calls release
+            ~GCPause();
+
+            /// @brief restore GC state early, if this is the outermost guard. Calling it more than once has no effect
+            void release();
+
+            /// @brief release the most recently constructed guard of the current thread that was not yet released, used by gc_unpause
+            static void release_innermost();
+
+            GCPause(const GCPause&) = delete;
+            GCPause& operator=(const GCPause&) = delete;
+
+        private:
+            bool _released = false;
+            const char* _file;
+            uint64_t _line;
+
+            // guards of the same thread that are not yet released, innermost first
+            GCPause* _previous;
+
+            // thread the guard was constructed on, only checked in debug builds
+            std::thread::id _thread_id;
+    };
+
+    /// @brief statistics about how long the GC stayed paused, only outermost guards are counted
+    struct GCPauseStatistics
+    {
+        /// @brief number of pauses
+        uint64_t n_pauses = 0;
+
+        /// @brief summed duration of all pauses
+        std::chrono::nanoseconds total_duration = std::chrono::nanoseconds(0);
+
+        /// @brief duration of the longest pause
+        std::chrono::nanoseconds max_duration = std::chrono::nanoseconds(0);
+
+        /// @brief summed duration per source location, formatted as "file:line", only populated while tracking is enabled
+        std::map<std::string, std::chrono::nanoseconds> duration_per_location;
+    };
+
+    /// @brief get statistics for all pauses since the last reset
+    /// @returns statistics
+    GCPauseStatistics get_gc_pause_statistics();
+
+    /// @brief reset statistics
+    void reset_gc_pause_statistics();
+
+    /// @brief enable or disable per-location attribution of pauses, disabled by default as it needs a lock per pause
+    /// @param enabled
+    void set_gc_pause_tracking(bool enabled);
+
     /// @brief access function in module
     /// @param module: pointer to module object
     /// @param name: function name
@@ -263,10 +329,14 @@ namespace jluna::unsafe
     T unsafe_unbox(unsafe::Value*);
 }
 
-/// @brief pause GC, remembers current state
-#define gc_pause bool __before__ = jl_gc_is_enabled(); jl_gc_enable(false);
+#define JLUNA_CONCAT_AUX(a, b) a##b
+#define JLUNA_CONCAT(a, b) JLUNA_CONCAT_AUX(a, b)
+
+/// @brief pause GC until the end of the current scope or until gc_unpause, remembers current state. Nests safely
+/// @note prefer declaring a jluna::unsafe::GCPause directly, which allows releasing a specific pause
+#define gc_pause jluna::unsafe::GCPause JLUNA_CONCAT(jluna_gc_pause_, __COUNTER__)(__FILE__, __LINE__);
 
-/// @brief restore GC state
-#define gc_unpause if (__before__) {jl_gc_enable(true); jl_gc_safepoint();}
+/// @brief release the innermost pause of the current thread, restores GC state if no outer pause of the same thread is still active
+#define gc_unpause jluna::unsafe::GCPause::release_innermost();
 
 #include <.src/unsafe_utilities.inl>
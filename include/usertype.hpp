@@ -10,6 +10,8 @@
 #include <include/type.hpp>
 #include <include/proxy.hpp>
 
+#include <optional>
+
 namespace jluna
 {
     /// @brief declare T to be a usertype at compile time, uses C++-side name as Julia-side typename
@@ -50,14 +52,31 @@ namespace jluna
                 std::function<void(T&, Field_t)> unbox_set = noop_set<Field_t>
             );
 
+            /// @brief add field that directly corresponds to a member of T
+            /// @param name: julia-side name of field
+            /// @param member: pointer to member, for example &T::_field
+            /// @note unlike fields added through add_property, these fields can be used by implement_as_isbits
+            template<typename Field_t>
+            static void add_field(const std::string& name, Field_t T::* member);
+
             /// @brief create the type, setup through the interface, julia-side
             /// @param module: module in which the type is evaluated
             static void implement(unsafe::Module* module = Main);
 
+            /// @brief create the type as an immutable isbits type whose memory layout is identical to that of T, julia-side
+            /// @param module: module in which the type is evaluated
+            /// @exceptions throws std::invalid_argument if a field was not added through add_field, JuliaException if the resulting type is not isbits or its layout does not match T
+            /// @note boxing and unboxing T, as well as std::vector<T>, will copy the bytes of each instance instead of boxing each field separately
+            static void implement_as_isbits(unsafe::Module* module = Main);
+
             /// @brief has implement() been called at least once
             /// @returns bool
             static bool is_implemented();
 
+            /// @brief was the type implemented using implement_as_isbits
+            /// @returns bool
+            static bool is_isbits();
+
             /// @brief box interface
             /// @param T&: instance
             /// @returns boxed value
@@ -73,6 +92,7 @@ namespace jluna
         private:
             static void initialize();
             static inline bool _implemented = false;
+            static inline bool _isbits = false;
 
             static inline std::unique_ptr<Type> _type = std::unique_ptr<Type>(nullptr);
             static inline std::unique_ptr<Symbol> _name = std::unique_ptr<Symbol>(nullptr);
@@ -81,7 +101,8 @@ namespace jluna
             static inline std::map<Symbol, std::tuple<
                 std::function<unsafe::Value*(T&)>,        // getter
                 std::function<void(T&, unsafe::Value*)>,   // setter
-                Type
+                Type,
+                std::optional<uint64_t>                    // offset, only for fields added through add_field
             >> _mapping = {};
     };
 
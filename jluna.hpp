@@ -16,7 +16,11 @@
 #include <include/unbox.hpp>
 #include <include/multi_threading.hpp>
 #include <include/proxy.hpp>
+#include <include/function.hpp>
 #include <include/array.hpp>
+#include <include/array_view.hpp>
+#include <include/parallel_algorithms.hpp>
+#include <include/simd.hpp>
 #include <include/cppcall.hpp>
 #include <include/type.hpp>
 #include <include/symbol.hpp>